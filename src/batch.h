@@ -0,0 +1,24 @@
+/*	batch.h
+**	-------------
+**
+**	Function prototypes for batch mode, which detects the systems under a
+**	list of root directories (chroots, unpacked images) in a worker pool.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_BATCH_H
+#define SCREENFETCH_C_BATCH_H
+
+#include <stdbool.h>
+
+#include "detect.h"
+
+/* the detectors that only need a system's files */
+#define BATCH_DETECTORS (DETECT_DISTRO | DETECT_KERNEL | DETECT_PKGS | DETECT_SHELL)
+#define BATCH_MAX_JOBS 256
+
+#ifdef __linux
+bool batch_run(const char *list, unsigned int jobs, bool json);
+#endif /* __linux */
+
+#endif /* SCREENFETCH_C_BATCH_H */
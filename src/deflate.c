@@ -0,0 +1,622 @@
+/*	deflate.c
+**	-------------
+**
+**	A small streaming zlib (RFC 1950 and 1951) compressor, for the PNG
+**	writer: LZ77 over a 32 KiB window with hash chains, and blocks coded
+**	with whichever of dynamic Huffman, fixed Huffman or stored is shortest.
+**	Level 0 only stores; 1-9 trade speed for size much like zlib's levels.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* program includes */
+#include "deflate.h"
+
+#define WSIZE 32768
+#define WMASK (WSIZE - 1)
+#define WIN_SIZE (2 * WSIZE)
+#define MIN_MATCH 3
+#define MAX_MATCH 258
+#define MIN_LOOKAHEAD (MAX_MATCH + MIN_MATCH + 1)
+#define HASH_BITS 15
+#define HASH_SIZE (1 << HASH_BITS)
+#define HASH(p) ((((unsigned int)(p)[0] << 10) ^ ((unsigned int)(p)[1] << 5) ^ (p)[2]) & \
+                 (HASH_SIZE - 1))
+#define MAX_SYMS 16384
+#define OUT_SIZE 32768
+#define STORED_MAX 65535
+
+#define N_LIT 286
+#define N_FIXED_LIT 288 /* the fixed code also has the two unused symbols */
+#define N_DIST 30
+#define N_CLEN 19
+
+/* how hard each level looks for matches */
+static const struct {
+  unsigned short max_chain, nice_len;
+  bool lazy;
+} levels[10] = {
+    {0, 0, false},      {4, 8, false},     {5, 16, false},    {6, 32, false},
+    {16, 16, true},     {32, 32, true},    {128, 128, true},  {256, 128, true},
+    {1024, 258, true},  {4096, 258, true},
+};
+
+static const uint16_t len_base[29] = {3,  4,  5,  6,  7,  8,  9,  10,  11,  13,
+                                      15, 17, 19, 23, 27, 31, 35, 43,  51,  59,
+                                      67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const unsigned char len_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                            2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t dist_base[30] = {1,    2,    3,    4,    5,    7,     9,     13,
+                                       17,   25,   33,   49,   65,   97,    129,   193,
+                                       257,  385,  513,  769,  1025, 1537,  2049,  3073,
+                                       4097, 6145, 8193, 12289, 16385, 24577};
+static const unsigned char dist_extra[30] = {0, 0, 0, 0, 1, 1, 2,  2,  3,  3,  4,  4,  5,  5,  6,
+                                             6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+static const unsigned char clen_order[N_CLEN] = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+                                                 11, 4,  12, 3, 13, 2, 14, 1, 15};
+static const unsigned char clen_extra[3] = {2, 3, 7};
+
+/*	adler32
+  updates the zlib checksum adler with len bytes at p
+*/
+static uint32_t adler32(uint32_t adler, const unsigned char *p, size_t len) {
+  uint32_t a = adler & 0xffff, b = adler >> 16;
+  size_t n;
+
+  while (len) {
+    /* 5552 is the most bytes that can be summed before b may overflow */
+    n = len < 5552 ? len : 5552;
+    len -= n;
+    while (n--) {
+      a += *p++;
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+  }
+
+  return (b << 16) | a;
+}
+
+static unsigned int len_code(unsigned int len) {
+  unsigned int c = 28;
+
+  while (len_base[c] > len)
+    c--;
+  return c;
+}
+
+static unsigned int dist_code(unsigned int dist) {
+  unsigned int c = 29;
+
+  while (dist_base[c] > dist)
+    c--;
+  return c;
+}
+
+/*	flush_out
+  hands the buffered output to the sink
+*/
+static void flush_out(struct deflate *z) {
+  if (z->out_len && !z->failed && !z->sink(z->ctx, z->out, z->out_len))
+    z->failed = true;
+  z->out_len = 0;
+}
+
+static void put_byte(struct deflate *z, unsigned char c) {
+  z->out[z->out_len++] = c;
+  if (z->out_len == OUT_SIZE)
+    flush_out(z);
+}
+
+/*	put_bits
+  writes the n low bits of value, least significant first
+*/
+static void put_bits(struct deflate *z, uint32_t value, unsigned int n) {
+  z->bits |= (uint64_t)value << z->n_bits;
+  z->n_bits += n;
+
+  while (z->n_bits >= 8) {
+    put_byte(z, z->bits & 0xff);
+    z->bits >>= 8;
+    z->n_bits -= 8;
+  }
+}
+
+static void align_bits(struct deflate *z) {
+  if (z->n_bits)
+    put_bits(z, 0, 8 - z->n_bits);
+}
+
+/*	huff_lengths
+  computes the code lengths of an optimal prefix code for the n frequencies,
+  no longer than limit: while the tree is too deep, the frequencies are
+  halved, which flattens it
+*/
+static void huff_lengths(const unsigned int *freq, int n, int limit, unsigned char *lens) {
+  unsigned int f[N_LIT], weight[2 * N_LIT];
+  int leaf[N_LIT], parent[2 * N_LIT], depth[2 * N_LIT];
+  int i, j, k, m, a, b, max;
+
+  for (i = 0, m = 0; i < n; i++) {
+    f[i] = freq[i];
+    lens[i] = 0;
+    m += f[i] != 0;
+  }
+
+  /* at least two codes, so that every code is complete */
+  for (i = 0; m < 2; i++) {
+    if (!f[i]) {
+      f[i] = 1;
+      m++;
+    }
+  }
+
+  for (;;) {
+    /* the used symbols, by increasing frequency */
+    for (i = 0, m = 0; i < n; i++) {
+      if (!f[i])
+        continue;
+      for (j = m++; j > 0 && f[leaf[j - 1]] > f[i]; j--)
+        leaf[j] = leaf[j - 1];
+      leaf[j] = i;
+    }
+
+    for (i = 0; i < m; i++)
+      weight[i] = f[leaf[i]];
+
+    /* nodes are made in increasing weight order, so the leaves and the nodes
+       are both queues, and the two lightest are at their fronts */
+    for (i = 0, j = m, k = m; k < 2 * m - 1; k++) {
+      a = (i < m && (j == k || weight[i] <= weight[j])) ? i++ : j++;
+      b = (i < m && (j == k || weight[i] <= weight[j])) ? i++ : j++;
+      weight[k] = weight[a] + weight[b];
+      parent[a] = parent[b] = k;
+    }
+
+    depth[2 * m - 2] = 0;
+    for (k = 2 * m - 3, max = 0; k >= 0; k--) {
+      depth[k] = depth[parent[k]] + 1;
+      if (k < m && depth[k] > max)
+        max = depth[k];
+    }
+
+    if (max <= limit)
+      break;
+
+    for (i = 0; i < n; i++)
+      f[i] = (f[i] + 1) / 2;
+  }
+
+  for (i = 0; i < m; i++)
+    lens[leaf[i]] = depth[i];
+}
+
+/*	huff_codes
+  assigns the canonical codes for the code lengths, bit-reversed since
+  deflate sends Huffman codes most significant bit first
+*/
+static void huff_codes(const unsigned char *lens, int n, uint16_t *codes) {
+  unsigned int count[16] = {0}, next[16], code = 0, c;
+  int i, b;
+
+  for (i = 0; i < n; i++)
+    count[lens[i]]++;
+  count[0] = 0;
+
+  for (b = 1; b < 16; b++) {
+    code = (code + count[b - 1]) << 1;
+    next[b] = code;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (!lens[i])
+      continue;
+    c = next[lens[i]]++;
+    for (codes[i] = 0, b = 0; b < lens[i]; b++, c >>= 1)
+      codes[i] = (codes[i] << 1) | (c & 1);
+  }
+}
+
+/*	data_bits
+  returns the size of the block's symbols in the given codes
+*/
+static size_t data_bits(const struct deflate *z, const unsigned char *lit_lens,
+                        const unsigned char *dist_lens) {
+  size_t bits = 0;
+  int i;
+
+  for (i = 0; i < N_LIT; i++)
+    bits += (size_t)z->lit_freq[i] * (lit_lens[i] + (i > 256 ? len_extra[i - 257] : 0));
+  for (i = 0; i < N_DIST; i++)
+    bits += (size_t)z->dist_freq[i] * (dist_lens[i] + dist_extra[i]);
+
+  return bits;
+}
+
+/*	put_syms
+  writes the block's symbols, and its end, in the given codes
+*/
+static void put_syms(struct deflate *z, const unsigned char *lit_lens, const uint16_t *lit_codes,
+                     const unsigned char *dist_lens, const uint16_t *dist_codes) {
+  unsigned int len, dist, c;
+  size_t i;
+
+  for (i = 0; i < z->n_syms; i++) {
+    if (!(dist = z->syms[2 * i + 1])) {
+      c = z->syms[2 * i];
+      put_bits(z, lit_codes[c], lit_lens[c]);
+      continue;
+    }
+
+    len = z->syms[2 * i] - 256;
+    c = len_code(len);
+    put_bits(z, lit_codes[257 + c], lit_lens[257 + c]);
+    put_bits(z, len - len_base[c], len_extra[c]);
+    c = dist_code(dist);
+    put_bits(z, dist_codes[c], dist_lens[c]);
+    put_bits(z, dist - dist_base[c], dist_extra[c]);
+  }
+
+  put_bits(z, lit_codes[256], lit_lens[256]);
+}
+
+/*	rle_lens
+  run-length codes the code lengths with the code length alphabet: 16
+  repeats the previous length, 17 and 18 are runs of zeroes; each entry of
+  out is a symbol and its extra bits
+  returns the number of entries
+*/
+static int rle_lens(const unsigned char *lens, int n, uint16_t *out, unsigned int *freq) {
+  int i = 0, run, r, m = 0;
+
+  while (i < n) {
+    for (run = 1; i + run < n && lens[i + run] == lens[i]; run++)
+      ;
+
+    if (!lens[i] && run >= 3) {
+      r = run > 138 ? 138 : run;
+      out[m++] = r >= 11 ? 18 | (r - 11) << 5 : 17 | (r - 3) << 5;
+      freq[r >= 11 ? 18 : 17]++;
+      i += r;
+    } else if (lens[i] && run >= 4) {
+      out[m++] = lens[i];
+      freq[lens[i]]++;
+      r = run - 1 > 6 ? 6 : run - 1;
+      out[m++] = 16 | (r - 3) << 5;
+      freq[16]++;
+      i += 1 + r;
+    } else {
+      out[m++] = lens[i];
+      freq[lens[i]]++;
+      i++;
+    }
+  }
+
+  return m;
+}
+
+/*	put_stored
+  writes len bytes of the window as stored blocks
+*/
+static void put_stored(struct deflate *z, const unsigned char *data, size_t len, bool last) {
+  size_t n;
+
+  do {
+    n = len > STORED_MAX ? STORED_MAX : len;
+    len -= n;
+    put_bits(z, last && !len, 3);
+    align_bits(z);
+    put_bits(z, n, 16);
+    put_bits(z, ~n & 0xffff, 16);
+    while (n--)
+      put_byte(z, *data++);
+  } while (len);
+}
+
+/*	flush_block
+  writes the symbols collected since the last block, in the shortest of the
+  three block types
+*/
+static void flush_block(struct deflate *z, bool last) {
+  unsigned char lit_lens[N_LIT], dist_lens[N_DIST], clen_lens[N_CLEN], all[N_LIT + N_DIST];
+  unsigned char fixed_lens[N_FIXED_LIT], fixed_dist[N_DIST];
+  uint16_t lit_codes[N_FIXED_LIT], dist_codes[N_DIST], clen_codes[N_CLEN], rle[N_LIT + N_DIST];
+  unsigned int clen_freq[N_CLEN] = {0};
+  size_t raw = z->pos - z->block_start, dyn_bits, fixed_bits, stored_bits;
+  int hlit, hdist, hclen, n_rle, i, c;
+
+  if (z->level == 0) {
+    put_stored(z, z->win + z->block_start, raw, last);
+    z->block_start = z->pos;
+    return;
+  }
+
+  z->lit_freq[256]++;
+
+  /* the dynamic code and its header */
+  huff_lengths(z->lit_freq, N_LIT, 15, lit_lens);
+  huff_lengths(z->dist_freq, N_DIST, 15, dist_lens);
+
+  for (hlit = N_LIT; hlit > 257 && !lit_lens[hlit - 1]; hlit--)
+    ;
+  for (hdist = N_DIST; hdist > 1 && !dist_lens[hdist - 1]; hdist--)
+    ;
+
+  memcpy(all, lit_lens, hlit);
+  memcpy(all + hlit, dist_lens, hdist);
+  n_rle = rle_lens(all, hlit + hdist, rle, clen_freq);
+  huff_lengths(clen_freq, N_CLEN, 7, clen_lens);
+
+  for (hclen = N_CLEN; hclen > 4 && !clen_lens[clen_order[hclen - 1]]; hclen--)
+    ;
+
+  dyn_bits = 3 + 5 + 5 + 4 + 3 * hclen + data_bits(z, lit_lens, dist_lens);
+  for (i = 0; i < N_CLEN; i++)
+    dyn_bits += (size_t)clen_freq[i] * (clen_lens[i] + (i >= 16 ? clen_extra[i - 16] : 0));
+
+  /* the fixed code, whose lengths cover all 288 symbols even though only 286 are used */
+  for (i = 0; i < N_FIXED_LIT; i++)
+    fixed_lens[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+  memset(fixed_dist, 5, N_DIST);
+  fixed_bits = 3 + data_bits(z, fixed_lens, fixed_dist);
+
+  stored_bits = (raw / STORED_MAX + 1) * 40 + raw * 8;
+
+  if (stored_bits <= dyn_bits && stored_bits <= fixed_bits) {
+    put_stored(z, z->win + z->block_start, raw, last);
+  } else if (fixed_bits <= dyn_bits) {
+    put_bits(z, last | 1 << 1, 3);
+    huff_codes(fixed_lens, N_FIXED_LIT, lit_codes);
+    huff_codes(fixed_dist, N_DIST, dist_codes);
+    put_syms(z, fixed_lens, lit_codes, fixed_dist, dist_codes);
+  } else {
+    put_bits(z, last | 2 << 1, 3);
+    put_bits(z, hlit - 257, 5);
+    put_bits(z, hdist - 1, 5);
+    put_bits(z, hclen - 4, 4);
+    for (i = 0; i < hclen; i++)
+      put_bits(z, clen_lens[clen_order[i]], 3);
+
+    huff_codes(clen_lens, N_CLEN, clen_codes);
+    for (i = 0; i < n_rle; i++) {
+      c = rle[i] & 0x1f;
+      put_bits(z, clen_codes[c], clen_lens[c]);
+      if (c >= 16)
+        put_bits(z, rle[i] >> 5, clen_extra[c - 16]);
+    }
+
+    huff_codes(lit_lens, N_LIT, lit_codes);
+    huff_codes(dist_lens, N_DIST, dist_codes);
+    put_syms(z, lit_lens, lit_codes, dist_lens, dist_codes);
+  }
+
+  memset(z->lit_freq, 0, sizeof(z->lit_freq));
+  memset(z->dist_freq, 0, sizeof(z->dist_freq));
+  z->n_syms = 0;
+  z->block_start = z->pos;
+}
+
+/*	insert
+  adds the string at p to its hash chain
+*/
+static void insert(struct deflate *z, size_t p) {
+  unsigned int h;
+
+  if (p + MIN_MATCH > z->win_len)
+    return;
+
+  h = HASH(z->win + p);
+  z->prev[p & WMASK] = z->head[h];
+  z->head[h] = (int32_t)p;
+}
+
+/*	longest_match
+  searches the hash chain of the string at p, which must not be inserted
+  yet, for the longest earlier match of at most max bytes
+  returns its length, or 0 if there is none of at least MIN_MATCH bytes
+*/
+static unsigned int longest_match(const struct deflate *z, size_t p, unsigned int max,
+                                  unsigned int *dist) {
+  const unsigned char *s = z->win + p, *c;
+  unsigned int chain = z->max_chain, best = MIN_MATCH - 1, len;
+  int32_t cand, next;
+
+  if (max < MIN_MATCH)
+    return 0;
+
+  for (cand = z->head[HASH(s)]; cand >= 0 && p - cand <= WSIZE && chain-- > 0; cand = next) {
+    c = z->win + cand;
+    if (c[best] == s[best] && c[0] == s[0] && c[1] == s[1]) {
+      for (len = 2; len < max && c[len] == s[len]; len++)
+        ;
+      if (len > best) {
+        best = len;
+        *dist = p - cand;
+        if (len >= z->nice_len || len == max)
+          break;
+      }
+    }
+
+    /* a slot of prev may have been reused by a newer string */
+    if ((next = z->prev[cand & WMASK]) >= cand)
+      break;
+  }
+
+  return best >= MIN_MATCH ? best : 0;
+}
+
+static void record(struct deflate *z, unsigned int litlen, unsigned int dist) {
+  z->syms[2 * z->n_syms] = litlen;
+  z->syms[2 * z->n_syms + 1] = dist;
+  z->n_syms++;
+
+  if (dist) {
+    z->lit_freq[257 + len_code(litlen - 256)]++;
+    z->dist_freq[dist_code(dist)]++;
+  } else {
+    z->lit_freq[litlen]++;
+  }
+}
+
+/*	deflate_process
+  compresses the window up to the lookahead, or to its end when flushing
+*/
+static void deflate_process(struct deflate *z, bool flush) {
+  size_t end = flush ? z->win_len : z->win_len > MIN_LOOKAHEAD ? z->win_len - MIN_LOOKAHEAD : 0;
+  unsigned int len, next_len, dist = 0, next_dist, max;
+
+  if (z->level == 0) {
+    if (z->pos < end)
+      z->pos = end;
+    return;
+  }
+
+  while (z->pos < end) {
+    max = z->win_len - z->pos < MAX_MATCH ? z->win_len - z->pos : MAX_MATCH;
+    len = longest_match(z, z->pos, max, &dist);
+    insert(z, z->pos);
+
+    /* if the next string matches further, this one is better sent as is */
+    if (len && z->lazy && len < z->nice_len && max > len) {
+      next_len = longest_match(z, z->pos + 1, max - 1, &next_dist);
+      if (next_len > len)
+        len = 0;
+    }
+
+    if (len) {
+      record(z, 256 + len, dist);
+      while (--len)
+        insert(z, ++z->pos);
+      z->pos++;
+    } else {
+      record(z, z->win[z->pos++], 0);
+    }
+
+    if (z->n_syms == MAX_SYMS)
+      flush_block(z, false);
+  }
+}
+
+/*	deflate_slide
+  drops the older half of the window, once the block that may still need
+  its bytes is written
+*/
+static void deflate_slide(struct deflate *z) {
+  size_t i;
+
+  flush_block(z, false);
+
+  memmove(z->win, z->win + WSIZE, z->win_len - WSIZE);
+  z->win_len -= WSIZE;
+  z->pos -= WSIZE;
+  z->block_start -= WSIZE;
+
+  for (i = 0; i < HASH_SIZE; i++)
+    z->head[i] = z->head[i] >= WSIZE ? z->head[i] - WSIZE : -1;
+  for (i = 0; i < WSIZE; i++)
+    z->prev[i] = z->prev[i] >= WSIZE ? z->prev[i] - WSIZE : -1;
+}
+
+/*	deflate_begin
+  starts a zlib stream at the given level (0-9), writing to sink
+  returns false if memory ran out
+*/
+bool deflate_begin(struct deflate *z, int level, deflate_sink sink, void *ctx) {
+  /* the header's check bits make it a multiple of 31 */
+  static const unsigned char flags[10] = {0x01, 0x01, 0x5e, 0x5e, 0x5e,
+                                          0x5e, 0x9c, 0xda, 0xda, 0xda};
+  size_t i;
+
+  memset(z, 0, sizeof(*z));
+  z->sink = sink;
+  z->ctx = ctx;
+  z->level = level;
+  z->max_chain = levels[level].max_chain;
+  z->nice_len = levels[level].nice_len;
+  z->lazy = levels[level].lazy;
+  z->adler = 1;
+
+  z->win = malloc(WIN_SIZE);
+  z->head = malloc(HASH_SIZE * sizeof(*z->head));
+  z->prev = malloc(WSIZE * sizeof(*z->prev));
+  z->syms = malloc(2 * MAX_SYMS * sizeof(*z->syms));
+  z->out = malloc(OUT_SIZE);
+
+  if (!z->win || !z->head || !z->prev || !z->syms || !z->out) {
+    deflate_free(z);
+    return false;
+  }
+
+  for (i = 0; i < HASH_SIZE; i++)
+    z->head[i] = -1;
+
+  put_byte(z, 0x78);
+  put_byte(z, flags[level]);
+
+  return true;
+}
+
+/*	deflate_write
+  compresses len more bytes of data
+  returns false if the sink gave up
+*/
+bool deflate_write(struct deflate *z, const void *data, size_t len) {
+  const unsigned char *p = data;
+  size_t n;
+
+  z->adler = adler32(z->adler, p, len);
+
+  while (len && !z->failed) {
+    if (z->win_len == WIN_SIZE)
+      deflate_slide(z);
+
+    n = WIN_SIZE - z->win_len < len ? WIN_SIZE - z->win_len : len;
+    memcpy(z->win + z->win_len, p, n);
+    z->win_len += n;
+    p += n;
+    len -= n;
+
+    deflate_process(z, false);
+  }
+
+  return !z->failed;
+}
+
+/*	deflate_finish
+  compresses what is left and ends the stream
+  returns false if the sink gave up
+*/
+bool deflate_finish(struct deflate *z) {
+  int i;
+
+  deflate_process(z, true);
+  flush_block(z, true);
+  align_bits(z);
+
+  for (i = 24; i >= 0; i -= 8)
+    put_byte(z, (z->adler >> i) & 0xff);
+  flush_out(z);
+
+  return !z->failed;
+}
+
+/*	deflate_free
+  releases the stream's buffers
+*/
+void deflate_free(struct deflate *z) {
+  free(z->win);
+  free(z->head);
+  free(z->prev);
+  free(z->syms);
+  free(z->out);
+  z->win = NULL;
+  z->head = z->prev = NULL;
+  z->syms = NULL;
+  z->out = NULL;
+}
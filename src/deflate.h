@@ -0,0 +1,46 @@
+/*	deflate.h
+**	-------------
+**
+**	Types and function prototypes for deflate.c, the zlib stream compressor.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_DEFLATE_H
+#define SCREENFETCH_C_DEFLATE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* receives each full buffer of compressed output; returns false to give up */
+typedef bool (*deflate_sink)(void *ctx, const unsigned char *data, size_t len);
+
+struct deflate {
+  deflate_sink sink;
+  void *ctx;
+  int level;
+  unsigned int max_chain, nice_len;
+  bool lazy;
+
+  unsigned char *win;       /* the input: matches are found in the older half */
+  size_t win_len, pos;      /* bytes in win, and the next one to compress */
+  size_t block_start;       /* where the block being collected starts in win */
+  int32_t *head, *prev;     /* the hash chains, as positions in win or -1 */
+  uint16_t *syms;           /* the block's literals and (length, distance) pairs */
+  size_t n_syms;
+  unsigned int lit_freq[286], dist_freq[30];
+  uint32_t adler;
+
+  uint64_t bits; /* output bits not yet whole bytes */
+  unsigned int n_bits;
+  unsigned char *out;
+  size_t out_len;
+  bool failed;
+};
+
+bool deflate_begin(struct deflate *z, int level, deflate_sink sink, void *ctx);
+bool deflate_write(struct deflate *z, const void *data, size_t len);
+bool deflate_finish(struct deflate *z);
+void deflate_free(struct deflate *z);
+
+#endif /* SCREENFETCH_C_DEFLATE_H */
@@ -9,14 +9,48 @@
 #ifndef SCREENFETCH_C_DETECT_H
 #define SCREENFETCH_C_DETECT_H
 
+#include <stdbool.h>
+
+/* one bit per detection function, so that an output can ask for only the
+   ones it shows */
+enum detector {
+  DETECT_DISTRO = 1 << 0,
+  DETECT_HOST = 1 << 1,
+  DETECT_KERNEL = 1 << 2,
+  DETECT_UPTIME = 1 << 3,
+  DETECT_PKGS = 1 << 4,
+  DETECT_CPU = 1 << 5,
+  DETECT_TOPOLOGY = 1 << 6,
+  DETECT_CPU_USAGE = 1 << 7,
+  DETECT_GPU = 1 << 8,
+  DETECT_DISK = 1 << 9,
+  DETECT_MEM = 1 << 10,
+  DETECT_SHELL = 1 << 11,
+  DETECT_RES = 1 << 12,
+  DETECT_DE = 1 << 13,
+  DETECT_WM = 1 << 14,
+  DETECT_WM_THEME = 1 << 15,
+  DETECT_GTK = 1 << 16,
+  DETECT_ALL = (1 << 17) - 1
+};
+
+/* the detectors that can describe another process's container: its files,
+   its cgroups and the kernel and hardware it shares with us */
+#define TARGET_DETECTORS                                                                       \
+  (DETECT_DISTRO | DETECT_HOST | DETECT_KERNEL | DETECT_UPTIME | DETECT_PKGS | DETECT_CPU |    \
+   DETECT_TOPOLOGY | DETECT_MEM | DETECT_SHELL)
+
 void detect_distro(void);
 void detect_host(void);
 void detect_kernel(void);
 void detect_uptime(void);
 void detect_pkgs(void);
 void detect_cpu(void);
+void detect_topology(void);
+void detect_cpu_usage_begin(bool per_core);
+void detect_cpu_usage(unsigned int interval_ms);
 void detect_gpu(void);
-void detect_disk(void);
+void detect_disk(bool per_fs);
 void detect_mem(void);
 void detect_shell(void);
 void detect_res(void);
@@ -25,4 +59,8 @@ void detect_wm(void);
 void detect_wm_theme(void);
 void detect_gtk(void);
 
+#ifdef __linux
+bool detect_target(unsigned long pid);
+#endif /* __linux */
+
 #endif /* SCREENFETCH_C_DETECT_H */
@@ -14,11 +14,13 @@
 
 /* program includes */
 #include "version.h"
-#include "logos.h"
 #include "colors.h"
 #include "misc.h"
 #include "disp.h"
-#include "arrays.h"
+#include "fields.h"
+#include "util.h"
+#include "distros.h"
+#include "render.h"
 
 /*	display_version
   called if the -V (--version) flag is tripped
@@ -37,6 +39,10 @@ void display_help(void) {
   printf("\n%s\n", "Options:\n"
                    "  -v, --verbose\t\t\t Enable verbosity during output.\n"
                    "  -s, --screenshot\t\t Take a screenshot.\n"
+                   "  -S, --screenshot-file [FILE]\t Save the screenshot to FILE.\n"
+                   "  -w, --screenshot-delay [SECS]\t Wait SECS seconds (3 by default) first.\n"
+                   "  -r, --render-png [FILE]\t Draw the output into a PNG file instead.\n"
+                   "  -z, --png-level [LEVEL]\t Compress PNGs at LEVEL, from 0 (none) to 9.\n"
                    "  -n, --no-logo\t\t\t Print output without a logo.\n"
                    "  -D, --distro [DISTRO]\t\t Print output with DISTRO's logo.\n"
                    "  -E, --suppress-errors\t\t Suppress error output.\n"
@@ -44,152 +50,177 @@ void display_help(void) {
                    "  -V, --version\t\t\t Output screenfetch-c's version and exit.\n"
                    "  -h, --help\t\t\t Output this help information.\n"
                    "  -L, --logo-only [DISTRO]\t Output only DISTRO's logo.\n"
+                   "  -i, --cpu-interval [MS]\t Show CPU usage, sampled over MS milliseconds.\n"
+                   "  -c, --per-core\t\t Show CPU usage, and that of each CPU as well.\n"
+                   "  -d, --disk-breakdown\t\t Show the usage of each filesystem as well.\n"
+                   "  -o, --output [FORMAT]\t\t Output json, kv or prometheus metrics instead.\n"
+                   "  -t, --textfile-dir [DIR]\t Write the prometheus metrics into DIR.\n"
+                   "  -f, --format [TEMPLATE]\t Print only TEMPLATE, e.g. '{user}@{host} {mem}'.\n"
+                   "  -u, --units [UNITS]\t\t Show sizes in iec (MiB) or si (MB) units.\n"
+                   "  -b, --batch [FILE]\t\t Detect the root directories listed in FILE.\n"
+                   "  -j, --jobs [N]\t\t Detect up to N roots at once in batch mode.\n"
+                   "  -P, --target-pid [PID]\t Describe the container of process PID.\n"
                    "For more information, consult screenfetch-c's man page.\n");
 
   return;
 }
 
+/* the rows of the normal output, in order; the host row is the colored user@host */
+#define ROW_HOST -1
+
+static const signed char rows[] = {
+    ROW_HOST,      FIELD_OS,   FIELD_KERNEL, FIELD_CPU,    FIELD_TOPOLOGY, FIELD_CPU_USAGE,
+    FIELD_GPU,     FIELD_SHELL, FIELD_PKGS,  FIELD_DISK,   FIELD_MEM,      FIELD_SWAP,
+    FIELD_UPTIME,  FIELD_RES,  FIELD_DE,     FIELD_WM,     FIELD_WM_THEME, FIELD_GTK,
+    FIELD_ICONS,   FIELD_FONT};
+
+#define N_ROWS (sizeof(rows) / sizeof(rows[0]))
+
+/*	shown_rows
+  fills shown with the rows to show: CPU usage is only measured when asked
+  for, so its row is left out when there is none
+  returns the number of rows
+*/
+static size_t shown_rows(signed char *shown) {
+  size_t i, n = 0;
+
+  for (i = 0; i < N_ROWS; i++) {
+    if (rows[i] != FIELD_CPU_USAGE || field_isset(FIELD_CPU_USAGE))
+      shown[n++] = rows[i];
+  }
+
+  return n;
+}
+
+/*	row_label
+  returns the label shown in front of a row
+*/
+static const char *row_label(int row) {
+  return row == ROW_HOST ? "" : field_defs[row].label;
+}
+
+/*	row_append
+  appends a row's value to the output frame
+*/
+static void row_append(int row) {
+  const struct distro *d;
+  const char *color;
+
+  if (row != ROW_HOST) {
+    field_append(row);
+    return;
+  }
+
+  /* the user@host line takes the distro's color */
+  d = distro_find(field_str(field_isset(FIELD_OS_BASE) ? FIELD_OS_BASE : FIELD_OS));
+  color = d ? d->color : TNRM;
+
+  /* with --target-pid, there is no user to show */
+  if (field_isset(FIELD_USER)) {
+    frame_append(color);
+    frame_append(field_str(FIELD_USER));
+    frame_append(TNRM TWHT "@" TNRM);
+  }
+
+  frame_append(color);
+  frame_append(field_str(FIELD_HOSTNAME));
+  frame_append(TNRM);
+}
+
 /*	display_verbose
   called if the -v (--verbose) flag is tripped
-  arguments: char *data[], *data_names[] the system data and names
 */
-void display_verbose(char *data[], char *data_names[]) {
-  int i = 0;
-  for (i = 0; i < DETECTED_ARR_LEN; i++)
-    VERBOSE_OUT(data_names[i], data[i]);
+void display_verbose(void) {
+  signed char shown[N_ROWS];
+  size_t i, n = shown_rows(shown);
+
+  for (i = 0; i < n; i++) {
+    frame_append(TLRD ":: " TNRM);
+    frame_append(row_label(shown[i]));
+    row_append(shown[i]);
+    frame_append("\n");
+  }
 
   return;
 }
 
 /*	process_logo_only
   output handling for output_logo_only
-  argument char *distro: the output logo
-  argument unsigned short int num: the length of the logo in lines
+  argument const struct logo *logo: the output logo
 */
-void process_logo_only(char *distro[], unsigned short int num) {
+void process_logo_only(const struct logo *logo) {
   unsigned short int x = 0;
 
-  for (x = 0; x < num; x++)
-    printf("%s\n", distro[x]);
+  for (x = 0; x < logo->n_lines; x++) {
+    frame_append(logo->lines[x]);
+    frame_append("\n");
+  }
 
   return;
 }
 
+/*	distro_logo
+  finds the logo for a distro: a pack logo named after the distro itself
+  (so that packs can add distros), then the one in its registry entry
+*/
+static const struct logo *distro_logo(const char *distro) {
+  const struct distro *d;
+  const struct logo *logo;
+
+  if ((logo = logo_find(distro)))
+    return logo;
+
+  return (d = distro_find(distro)) ? logo_find(d->logo) : NULL;
+}
+
 /*	output_logo_only
   outputs an ASCII logo based upon the distro name passed to it
   argument char *distro: the name of the distro to output
 */
 void output_logo_only(char *distro) {
-  if (STREQ(distro, "Windows")) {
-    process_logo_only(windows_logo, 16);
-  } else if (strstr(distro, "OS X") || strstr(distro, "Mac OS") || strstr(distro, "macOS")) {
-    process_logo_only(macosx_logo, 16);
-  } else if (STREQ(distro, "Arch Linux - Old")) {
-    process_logo_only(oldarch_logo, 18);
-  } else if (STREQ(distro, "Arch Linux")) {
-    process_logo_only(arch_logo, 19);
-  } else if (STREQ(distro, "LinuxMint")) {
-    process_logo_only(mint_logo, 18);
-  } else if (STREQ(distro, "LMDE")) {
-    process_logo_only(lmde_logo, 18);
-  } else if (STREQ(distro, "Ubuntu") || STREQ(distro, "Lubuntu") || STREQ(distro, "Xubuntu")) {
-    process_logo_only(ubuntu_logo, 18);
-  } else if (STREQ(distro, "Debian")) {
-    process_logo_only(debian_logo, 18);
-  } else if (STREQ(distro, "CrunchBang")) {
-    process_logo_only(crunchbang_logo, 18);
-  } else if (STREQ(distro, "Gentoo")) {
-    process_logo_only(gentoo_logo, 18);
-  } else if (STREQ(distro, "Funtoo")) {
-    process_logo_only(funtoo_logo, 18);
-  } else if (STREQ(distro, "Fedora")) {
-    process_logo_only(fedora_logo, 18);
-  } else if (STREQ(distro, "Mandriva") || STREQ(distro, "Mandrake")) {
-    process_logo_only(mandriva_mandrake_logo, 18);
-  } else if (STREQ(distro, "OpenSUSE")) {
-    process_logo_only(opensuse_logo, 18);
-  } else if (STREQ(distro, "Slackware")) {
-    process_logo_only(slackware_logo, 21);
-  } else if (STREQ(distro, "Red Hat Linux")) {
-    process_logo_only(redhat_logo, 18);
-  } else if (STREQ(distro, "Frugalware")) {
-    process_logo_only(frugalware_logo, 23);
-  } else if (STREQ(distro, "Peppermint")) {
-    process_logo_only(peppermint_logo, 19);
-  } else if (STREQ(distro, "SolusOS")) {
-    process_logo_only(solusos_logo, 18);
-  } else if (STREQ(distro, "Mageia")) {
-    process_logo_only(mageia_logo, 18);
-  } else if (STREQ(distro, "ParabolaGNU/Linux-libre")) {
-    process_logo_only(parabolagnu_linuxlibre_logo, 18);
-  } else if (STREQ(distro, "Viperr")) {
-    process_logo_only(viperr_logo, 18);
-  } else if (STREQ(distro, "LinuxDeepin")) {
-    process_logo_only(linuxdeepin_logo, 18);
-  } else if (STREQ(distro, "Chakra")) {
-    process_logo_only(chakra_logo, 18);
-  } else if (STREQ(distro, "Fuduntu")) {
-    process_logo_only(fuduntu_logo, 21);
-  } else if (STREQ(distro, "Trisquel")) {
-    process_logo_only(trisquel_logo, 18);
-  } else if (STREQ(distro, "Manjaro")) {
-    process_logo_only(manjaro_logo, 18);
-  } else if (STREQ(distro, "elementary OS")) {
-    process_logo_only(elementaryos_logo, 18);
-  } else if (STREQ(distro, "Scientific Linux")) {
-    process_logo_only(scientificlinux_logo, 20);
-  } else if (STREQ(distro, "Backtrack Linux")) {
-    process_logo_only(backtracklinux_logo, 21);
-  } else if (STREQ(distro, "Kali Linux")) {
-    process_logo_only(kalilinux_logo, 21);
-  } else if (STREQ(distro, "Sabayon")) {
-    process_logo_only(sabayon_logo, 18);
-  } else if (STREQ(distro, "FreeBSD")) {
-    process_logo_only(freebsd_logo, 18);
-  } else if (STREQ(distro, "OpenBSD")) {
-    process_logo_only(openbsd_logo, 23);
-  } else if (STREQ(distro, "NetBSD")) {
-    process_logo_only(netbsd_logo, 20);
-  } else if (STREQ(distro, "DragonFly BSD")) {
-    process_logo_only(dragonflybsd_logo, 18);
-  } else if (STREQ(distro, "Android")) {
-    process_logo_only(android_logo, 16);
-  } else if (STREQ(distro, "Solaris")) {
-    process_logo_only(solaris_logo, 17);
-  } else if (STREQ(distro, "Angstrom")) {
-    process_logo_only(angstrom_logo, 16);
-  } else /* if (STREQ(distro_str, "Linux")) */
-  {
-    process_logo_only(linux_logo, 16);
-  }
+  const struct logo *logo;
+
+  if ((logo = distro_logo(distro)) || (logo = distro_logo("Linux")))
+    process_logo_only(logo);
+  else
+    ERR_REPORT("Could not find a logo for the distro.");
 
   return;
 }
 
 /* process_data
    output handling main_ascii_output
-   argument char *data[]: the data being output
-   argument char *data_names[]: the name associated with each datum
-   argument char *logo[]: the logo associated with the distro
-   argument unsigned short int num1, num2: indices for the data
-   argument char *col1..3: colors for the output
+   argument const struct logo *logo: the logo associated with the distro;
+   whichever of the logo and the rows runs out first is padded so that
+   every logo line and every row is printed
 */
-void process_data(char *data[], char *data_names[], char *logo[], unsigned short int num1,
-                  unsigned short int num2, char *col1, char *col2, char *col3) {
+void process_data(const struct logo *logo) {
+  signed char shown[N_ROWS];
   unsigned short int x = 0;
+  unsigned short int rows_shown, n = shown_rows(shown);
+
+  rows_shown = logo->n_lines > n ? logo->n_lines : n;
 
-  if (0 == num2) {
-    for (x = 0; x < num1; x++) {
-      printf("%s %s%s%s%s%s%s\n", logo[x], col1, col2, col3, data_names[x], TNRM, data[x]);
+  for (x = 0; x < rows_shown; x++) {
+    /* pad every line to the widest one, so the data lines up */
+    if (x < logo->n_lines) {
+      frame_append(logo->lines[x]);
+      frame_pad(logo->width - logo->widths[x]);
+    } else {
+      frame_pad(logo->width);
     }
-  } else {
-    for (x = 0; x < num1; x++) {
-      if (x < num2) {
-        printf("%s %s%s%s%s%s%s\n", logo[x], col1, col2, col3, data_names[x], TNRM, data[x]);
-      } else {
-        printf("%s\n", logo[x]);
-      }
+
+    if (x < n) {
+      frame_append(" ");
+      frame_append(logo->col1);
+      frame_append(logo->col2);
+      frame_append(logo->col3);
+      frame_append(row_label(shown[x]));
+      frame_append(TNRM);
+      row_append(shown[x]);
     }
+
+    frame_append("\n");
   }
 
   return;
@@ -197,92 +228,17 @@ void process_data(char *data[], char *data_names[], char *logo[], unsigned short
 
 /*	main_ascii_output
   the primary output for screenfetch-c
-  arguments char *data[], char *data_names[]:
 */
-void main_ascii_output(char *data[], char *data_names[]) {
-  if (strstr(data[1], "Microsoft Windows 8") || strstr(data[1], "Microsoft Windows 10")) {
-    process_data(data, data_names, windows_modern_logo, 19, DETECTED_ARR_LEN, TLBL, TNRM, TLBL);
-  } else if (strstr(data[1], "Microsoft")) {
-    process_data(data, data_names, windows_logo, 16, DETECTED_ARR_LEN, TRED, TWHT, TRED);
-  } else if (strstr(data[1], "OS X") || strstr(data[1], "Mac OS") || strstr(data[1], "macOS")) {
-    process_data(data, data_names, macosx_logo, 16, DETECTED_ARR_LEN, TLBL, TNRM, TLBL);
-  } else if (STREQ(data[1], "Arch Linux - Old")) {
-    process_data(data, data_names, oldarch_logo, 18, DETECTED_ARR_LEN, TLBL, TNRM, TLBL);
-  } else if (STREQ(data[1], "Arch Linux")) {
-    process_data(data, data_names, arch_logo, 19, DETECTED_ARR_LEN, TLCY, TNRM, TLCY);
-  } else if (STREQ(data[1], "LinuxMint")) {
-    process_data(data, data_names, mint_logo, 18, DETECTED_ARR_LEN, TLGN, TNRM, TLGN);
-  } else if (STREQ(data[1], "LMDE")) {
-    process_data(data, data_names, lmde_logo, 18, DETECTED_ARR_LEN, TLGN, TNRM, TLGN);
-  } else if (STREQ(data[1], "Ubuntu") || STREQ(data[1], "Lubuntu") || STREQ(data[1], "Xubuntu")) {
-    process_data(data, data_names, ubuntu_logo, 18, DETECTED_ARR_LEN, TLRD, TNRM, TLRD);
-  } else if (STREQ(data[1], "Debian")) {
-    process_data(data, data_names, debian_logo, 18, DETECTED_ARR_LEN, TLRD, TNRM, TLRD);
-  } else if (STREQ(data[1], "CrunchBang")) {
-    process_data(data, data_names, crunchbang_logo, 18, DETECTED_ARR_LEN, TDGY, TNRM, TDGY);
-  } else if (STREQ(data[1], "Gentoo")) {
-    process_data(data, data_names, gentoo_logo, 18, DETECTED_ARR_LEN, TLPR, TNRM, TLPR);
-  } else if (STREQ(data[1], "Funtoo")) {
-    process_data(data, data_names, funtoo_logo, 18, DETECTED_ARR_LEN, TLPR, TNRM, TLPR);
-  } else if (STREQ(data[1], "Fedora")) {
-    process_data(data, data_names, fedora_logo, 18, DETECTED_ARR_LEN, TLBL, TNRM, TLBL);
-  } else if (STREQ(data[1], "Mandriva") || STREQ(data[1], "Mandrake")) {
-    process_data(data, data_names, mandriva_mandrake_logo, 18, DETECTED_ARR_LEN, TLBL, TNRM, TLBL);
-  } else if (STREQ(data[1], "OpenSUSE")) {
-    process_data(data, data_names, opensuse_logo, 18, DETECTED_ARR_LEN, TLGN, TNRM, TLGN);
-  } else if (STREQ(data[1], "Slackware")) {
-    process_data(data, data_names, slackware_logo, 21, DETECTED_ARR_LEN, TLBL, TNRM, TLBL);
-  } else if (STREQ(data[1], "Red Hat Linux")) {
-    process_data(data, data_names, redhat_logo, 18, DETECTED_ARR_LEN, TRED, TNRM, TRED);
-  } else if (STREQ(data[1], "Frugalware")) {
-    process_data(data, data_names, frugalware_logo, 23, DETECTED_ARR_LEN, TLCY, TNRM, TLCY);
-  } else if (STREQ(data[1], "Peppermint")) {
-    process_data(data, data_names, peppermint_logo, 18, DETECTED_ARR_LEN, TLRD, TNRM, TLRD);
-  } else if (STREQ(data[1], "SolusOS")) {
-    process_data(data, data_names, solusos_logo, 18, DETECTED_ARR_LEN, TLGY, TNRM, TLGY);
-  } else if (STREQ(data[1], "Mageia")) {
-    process_data(data, data_names, mageia_logo, 18, DETECTED_ARR_LEN, TLGY, TNRM, TLGY);
-  } else if (STREQ(data[1], "ParabolaGNU/Linux-libre")) {
-    process_data(data, data_names, parabolagnu_linuxlibre_logo, 18, DETECTED_ARR_LEN, TLGY, TLPR,
-                 TLGY);
-  } else if (STREQ(data[1], "Viperr")) {
-    process_data(data, data_names, viperr_logo, 18, DETECTED_ARR_LEN, TLGY, TNRM, TLGY);
-  } else if (STREQ(data[1], "LinuxDeepin")) {
-    process_data(data, data_names, linuxdeepin_logo, 18, DETECTED_ARR_LEN, TLGN, TNRM, TLGN);
-  } else if (STREQ(data[1], "Chakra")) {
-    process_data(data, data_names, chakra_logo, 18, DETECTED_ARR_LEN, TLBL, TNRM, TLBL);
-  } else if (STREQ(data[1], "Fuduntu")) {
-    process_data(data, data_names, fuduntu_logo, 21, DETECTED_ARR_LEN, TLRD, TNRM, TLRD);
-  } else if (STREQ(data[1], "Trisquel")) {
-    process_data(data, data_names, trisquel_logo, 18, DETECTED_ARR_LEN, TLBL, TNRM, TLBL);
-  } else if (STREQ(data[1], "Manjaro")) {
-    process_data(data, data_names, manjaro_logo, 18, DETECTED_ARR_LEN, TNRM, TNRM, TNRM);
-  } else if (STREQ(data[1], "elementary OS")) {
-    process_data(data, data_names, elementaryos_logo, 18, DETECTED_ARR_LEN, TLGN, TNRM, TLGN);
-  } else if (STREQ(data[1], "Scientific Linux")) {
-    process_data(data, data_names, scientificlinux_logo, 20, DETECTED_ARR_LEN, TLRD, TNRM, TLRD);
-  } else if (STREQ(data[1], "Backtrack Linux")) {
-    process_data(data, data_names, backtracklinux_logo, 21, DETECTED_ARR_LEN, TLRD, TNRM, TLRD);
-  } else if (STREQ(data[1], "Kali Linux")) {
-    process_data(data, data_names, backtracklinux_logo, 21, DETECTED_ARR_LEN, TLBL, TNRM, TLBL);
-  } else if (STREQ(data[1], "Sabayon")) {
-    process_data(data, data_names, sabayon_logo, 18, DETECTED_ARR_LEN, TLBL, TNRM, TLBL);
-  } else if (STREQ(data[1], "Android")) {
-    process_data(data, data_names, android_logo, 16, DETECTED_ARR_LEN, TLGN, TNRM, TLGN);
-  } else if (STREQ(data[1], "Angstrom")) {
-    process_data(data, data_names, angstrom_logo, 16, DETECTED_ARR_LEN, TNRM, TNRM, TNRM);
-  } else if (STREQ(data[1], "Linux")) {
-    process_data(data, data_names, linux_logo, 18, DETECTED_ARR_LEN, TLGY, TNRM, TLGY);
-  } else if (STREQ(data[1], "FreeBSD")) {
-    process_data(data, data_names, freebsd_logo, 18, DETECTED_ARR_LEN, TLRD, TNRM, TLRD);
-  } else if (STREQ(data[1], "OpenBSD")) {
-    process_data(data, data_names, openbsd_logo, 23, DETECTED_ARR_LEN, TNRM, TNRM, TNRM);
-  } else if (STREQ(data[1], "NetBSD")) {
-    process_data(data, data_names, netbsd_logo, 23, DETECTED_ARR_LEN, TNRM, TNRM, TNRM);
-  } else if (STREQ(data[1], "DragonFly BSD")) {
-    process_data(data, data_names, dragonflybsd_logo, 23, DETECTED_ARR_LEN, TNRM, TNRM, TNRM);
-  } else if (STREQ(data[1], "SunOS")) {
-    process_data(data, data_names, solaris_logo, 17, DETECTED_ARR_LEN, TNRM, TNRM, TNRM);
+void main_ascii_output(void) {
+  /* derivatives use the logo of the distro they are based on */
+  const struct logo *logo;
+  char distro[MAX_STRLEN];
+
+  safe_strncpy(distro, field_str(field_isset(FIELD_OS_BASE) ? FIELD_OS_BASE : FIELD_OS),
+               MAX_STRLEN);
+
+  if ((logo = distro_logo(distro))) {
+    process_data(logo);
   } else {
     ERR_REPORT("Could not find a logo for the distro.");
   }
@@ -292,13 +248,17 @@ void main_ascii_output(char *data[], char *data_names[]) {
 
 /*	main_text_output
   the secondary output for screenfetch-c - all info WITHOUT ASCII art
-  arguments char *data[], char *data_names[]
 */
-void main_text_output(char *data[], char *data_names[]) {
-  int i;
+void main_text_output(void) {
+  signed char shown[N_ROWS];
+  size_t i, n = shown_rows(shown);
 
-  for (i = 0; i < DETECTED_ARR_LEN; i++)
-    printf("%s %s\n", data_names[i], data[i]);
+  for (i = 0; i < n; i++) {
+    frame_append(row_label(shown[i]));
+    frame_append(" ");
+    row_append(shown[i]);
+    frame_append("\n");
+  }
 
   return;
 }
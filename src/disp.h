@@ -11,16 +11,16 @@
 #define SCREENFETCH_C_DISP_H
 
 #include "colors.h"
+#include "logos.h"
 
 void display_version(void);
 void display_help(void);
-void display_verbose(char *data[], char *data_names[]);
-void process_logo_only(char *distro[], unsigned short int num);
+void display_verbose(void);
+void process_logo_only(const struct logo *logo);
 void output_logo_only(char *distro);
-void process_data(char *data[], char *data_names[], char *logo[], unsigned short int num1,
-                  unsigned short int num2, char *col1, char *col2, char *col3);
-void main_ascii_output(char *data[], char *data_names[]);
-void main_text_output(char *data[], char *data_names[]);
+void process_data(const struct logo *logo);
+void main_ascii_output(void);
+void main_text_output(void);
 
 #define ERR_REPORT(str)                                                                            \
   (fprintf(stderr, TWHT "[[ " TLRD "!" TWHT " ]] " TNRM "Error: %s (%s:%d)\n", str, __FILE__,      \
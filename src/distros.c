@@ -0,0 +1,213 @@
+/*	distros.c
+**	-------------
+**
+**	The registry of distros (and other OSes) screenfetch-c knows about.
+**	Each one is described once, and every name it may go by is resolved to
+**	that description with a single binary search.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdlib.h>
+#include <string.h>
+
+/* program includes */
+#include "distros.h"
+#include "misc.h"
+#include "colors.h"
+
+enum distro_id {
+  DISTRO_OLDARCH,
+  DISTRO_ARCH,
+  DISTRO_MINT,
+  DISTRO_LMDE,
+  DISTRO_UBUNTU,
+  DISTRO_DEBIAN,
+  DISTRO_CRUNCHBANG,
+  DISTRO_GENTOO,
+  DISTRO_FUNTOO,
+  DISTRO_FEDORA,
+  DISTRO_MANDRIVA,
+  DISTRO_OPENSUSE,
+  DISTRO_SLACKWARE,
+  DISTRO_REDHAT,
+  DISTRO_FRUGALWARE,
+  DISTRO_PEPPERMINT,
+  DISTRO_SOLUSOS,
+  DISTRO_MAGEIA,
+  DISTRO_PARABOLA,
+  DISTRO_VIPERR,
+  DISTRO_DEEPIN,
+  DISTRO_CHAKRA,
+  DISTRO_FUDUNTU,
+  DISTRO_TRISQUEL,
+  DISTRO_MANJARO,
+  DISTRO_ELEMENTARY,
+  DISTRO_SCIENTIFIC,
+  DISTRO_BACKTRACK,
+  DISTRO_KALI,
+  DISTRO_SABAYON,
+  DISTRO_ANDROID,
+  DISTRO_ANGSTROM,
+  DISTRO_LINUX,
+  DISTRO_FREEBSD,
+  DISTRO_OPENBSD,
+  DISTRO_NETBSD,
+  DISTRO_DRAGONFLY,
+  DISTRO_SOLARIS,
+  DISTRO_MACOSX,
+  DISTRO_WINDOWS,
+  DISTRO_WINDOWS_MODERN,
+  DISTRO_COUNT
+};
+
+static const struct distro distros[DISTRO_COUNT] = {
+    [DISTRO_OLDARCH] = {"Arch Linux - Old", "oldarch", PKG_NONE, TLCY},
+    [DISTRO_ARCH] = {"Arch Linux", "arch", PKG_PACMAN, TLCY},
+    [DISTRO_MINT] = {"LinuxMint", "mint", PKG_DPKG, TLGN},
+    [DISTRO_LMDE] = {"LMDE", "lmde", PKG_DPKG, TLGN},
+    [DISTRO_UBUNTU] = {"Ubuntu", "ubuntu", PKG_DPKG, TLRD},
+    [DISTRO_DEBIAN] = {"Debian", "debian", PKG_DPKG, TLRD},
+    [DISTRO_CRUNCHBANG] = {"CrunchBang", "crunchbang", PKG_DPKG, TDGY},
+    [DISTRO_GENTOO] = {"Gentoo", "gentoo", PKG_PORTAGE, TLPR},
+    [DISTRO_FUNTOO] = {"Funtoo", "funtoo", PKG_PORTAGE, TLPR},
+    [DISTRO_FEDORA] = {"Fedora", "fedora", PKG_RPM, TLBL},
+    [DISTRO_MANDRIVA] = {"Mandriva", "mandriva_mandrake", PKG_RPM, TLBL},
+    [DISTRO_OPENSUSE] = {"OpenSUSE", "opensuse", PKG_RPM, TLGN},
+    [DISTRO_SLACKWARE] = {"Slackware", "slackware", PKG_SLACKWARE, TLBL},
+    [DISTRO_REDHAT] = {"Red Hat Linux", "redhat", PKG_RPM, TLRD},
+    [DISTRO_FRUGALWARE] = {"Frugalware", "frugalware", PKG_PACMAN_G2, TLCY},
+    [DISTRO_PEPPERMINT] = {"Peppermint", "peppermint", PKG_DPKG, TLRD},
+    [DISTRO_SOLUSOS] = {"SolusOS", "solusos", PKG_DPKG, TLGY},
+    [DISTRO_MAGEIA] = {"Mageia", "mageia", PKG_RPM, TLGY},
+    [DISTRO_PARABOLA] = {"ParabolaGNU/Linux-libre", "parabolagnu_linuxlibre", PKG_PACMAN, TLPR},
+    [DISTRO_VIPERR] = {"Viperr", "viperr", PKG_RPM, TDGY},
+    [DISTRO_DEEPIN] = {"LinuxDeepin", "linuxdeepin", PKG_DPKG, TLGN},
+    [DISTRO_CHAKRA] = {"Chakra", "chakra", PKG_PACMAN, TLBL},
+    [DISTRO_FUDUNTU] = {"Fuduntu", "fuduntu", PKG_RPM, TLGY},
+    [DISTRO_TRISQUEL] = {"Trisquel", "trisquel", PKG_DPKG, TLBL},
+    [DISTRO_MANJARO] = {"Manjaro", "manjaro", PKG_PACMAN, TLGN},
+    [DISTRO_ELEMENTARY] = {"elementary OS", "elementaryos", PKG_DPKG, TLGN},
+    [DISTRO_SCIENTIFIC] = {"Scientific Linux", "scientificlinux", PKG_RPM, TLRD},
+    [DISTRO_BACKTRACK] = {"Backtrack Linux", "backtracklinux", PKG_DPKG, TLRD},
+    [DISTRO_KALI] = {"Kali Linux", "kalilinux", PKG_DPKG, TLBL},
+    [DISTRO_SABAYON] = {"Sabayon", "sabayon", PKG_PORTAGE, TLBL},
+    [DISTRO_ANDROID] = {"Android", "android", PKG_NONE, TLGN},
+    [DISTRO_ANGSTROM] = {"Angstrom", "angstrom", PKG_OPKG, TNRM},
+    [DISTRO_LINUX] = {"Linux", "linux", PKG_UNKNOWN, TLGY},
+    [DISTRO_FREEBSD] = {"FreeBSD", "freebsd", PKG_NONE, TLRD},
+    [DISTRO_OPENBSD] = {"OpenBSD", "openbsd", PKG_NONE, TNRM},
+    [DISTRO_NETBSD] = {"NetBSD", "netbsd", PKG_NONE, TNRM},
+    [DISTRO_DRAGONFLY] = {"DragonFly BSD", "dragonflybsd", PKG_NONE, TNRM},
+    [DISTRO_SOLARIS] = {"Solaris", "solaris", PKG_NONE, TNRM},
+    [DISTRO_MACOSX] = {"OS X", "macosx", PKG_NONE, TLBL},
+    [DISTRO_WINDOWS] = {"Windows", "windows", PKG_NONE, TRED},
+    [DISTRO_WINDOWS_MODERN] = {"Windows 10", "windows_modern", PKG_NONE, TLBL},
+};
+
+struct distro_alias {
+  const char *name;
+  enum distro_id id;
+};
+
+/* every accepted name, sorted in strcmp() order for bsearch() */
+static const struct distro_alias aliases[] = {
+    {"Android", DISTRO_ANDROID},
+    {"Angstrom", DISTRO_ANGSTROM},
+    {"Arch Linux", DISTRO_ARCH},
+    {"Arch Linux - Old", DISTRO_OLDARCH},
+    {"Backtrack Linux", DISTRO_BACKTRACK},
+    {"Chakra", DISTRO_CHAKRA},
+    {"CrunchBang", DISTRO_CRUNCHBANG},
+    {"Debian", DISTRO_DEBIAN},
+    {"DragonFly BSD", DISTRO_DRAGONFLY},
+    {"Fedora", DISTRO_FEDORA},
+    {"FreeBSD", DISTRO_FREEBSD},
+    {"Frugalware", DISTRO_FRUGALWARE},
+    {"Fuduntu", DISTRO_FUDUNTU},
+    {"Funtoo", DISTRO_FUNTOO},
+    {"Gentoo", DISTRO_GENTOO},
+    {"Kali Linux", DISTRO_KALI},
+    {"LMDE", DISTRO_LMDE},
+    {"Linux", DISTRO_LINUX},
+    {"LinuxDeepin", DISTRO_DEEPIN},
+    {"LinuxMint", DISTRO_MINT},
+    {"Lubuntu", DISTRO_UBUNTU},
+    {"Mageia", DISTRO_MAGEIA},
+    {"Mandrake", DISTRO_MANDRIVA},
+    {"Mandriva", DISTRO_MANDRIVA},
+    {"Manjaro", DISTRO_MANJARO},
+    {"NetBSD", DISTRO_NETBSD},
+    {"OS X", DISTRO_MACOSX},
+    {"OpenBSD", DISTRO_OPENBSD},
+    {"OpenSUSE", DISTRO_OPENSUSE},
+    {"ParabolaGNU/Linux-libre", DISTRO_PARABOLA},
+    {"Peppermint", DISTRO_PEPPERMINT},
+    {"Red Hat Linux", DISTRO_REDHAT},
+    {"Sabayon", DISTRO_SABAYON},
+    {"Scientific Linux", DISTRO_SCIENTIFIC},
+    {"Slackware", DISTRO_SLACKWARE},
+    {"Solaris", DISTRO_SOLARIS},
+    {"SolusOS", DISTRO_SOLUSOS},
+    {"SunOS", DISTRO_SOLARIS},
+    {"Trisquel", DISTRO_TRISQUEL},
+    {"Ubuntu", DISTRO_UBUNTU},
+    {"Viperr", DISTRO_VIPERR},
+    {"Windows", DISTRO_WINDOWS},
+    {"Windows 10", DISTRO_WINDOWS_MODERN},
+    {"Xubuntu", DISTRO_UBUNTU},
+    {"elementary OS", DISTRO_ELEMENTARY},
+};
+
+/* names that only need to contain a marker, such as Windows and OS X
+   versions; checked in order, after the exact names */
+static const struct distro_alias markers[] = {
+    {"Microsoft Windows 8", DISTRO_WINDOWS_MODERN},
+    {"Microsoft Windows 10", DISTRO_WINDOWS_MODERN},
+    {"Microsoft", DISTRO_WINDOWS},
+    {"OS X", DISTRO_MACOSX},
+    {"Mac OS", DISTRO_MACOSX},
+    {"macOS", DISTRO_MACOSX},
+};
+
+/*	cmp_alias
+  bsearch comparator between a name and an alias
+*/
+static int cmp_alias(const void *key, const void *alias) {
+  return strcmp(key, ((const struct distro_alias *)alias)->name);
+}
+
+/*	distro_aliases_unsorted
+  checks that the aliases are in the order distro_find needs; for the tests
+  returns the first alias that is out of order, or NULL if none is
+*/
+const char *distro_aliases_unsorted(void) {
+  size_t i;
+
+  for (i = 1; i < sizeof(aliases) / sizeof(aliases[0]); i++) {
+    if (strcmp(aliases[i - 1].name, aliases[i].name) >= 0)
+      return aliases[i].name;
+  }
+
+  return NULL;
+}
+
+/*	distro_find
+  looks up the registry entry for a distro or OS name
+  returns NULL if the name is unknown
+*/
+const struct distro *distro_find(const char *name) {
+  const struct distro_alias *alias;
+  size_t i;
+
+  if ((alias = bsearch(name, aliases, sizeof(aliases) / sizeof(aliases[0]), sizeof(aliases[0]),
+                       cmp_alias)))
+    return &distros[alias->id];
+
+  for (i = 0; i < sizeof(markers) / sizeof(markers[0]); i++) {
+    if (strstr(name, markers[i].name))
+      return &distros[markers[i].id];
+  }
+
+  return NULL;
+}
@@ -0,0 +1,35 @@
+/*	distros.h
+**	-------------
+**
+**	The registry of distros (and other OSes) screenfetch-c knows about:
+**	their names, logos, colors and package managers.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_DISTROS_H
+#define SCREENFETCH_C_DISTROS_H
+
+/* how packages are counted on a Linux distro */
+enum pkg_backend {
+  PKG_NONE,    /* not a Linux distro, or none known: leave the count alone */
+  PKG_UNKNOWN, /* generic Linux: report that packages cannot be counted */
+  PKG_PACMAN,
+  PKG_PACMAN_G2,
+  PKG_DPKG,
+  PKG_SLACKWARE,
+  PKG_PORTAGE,
+  PKG_RPM,
+  PKG_OPKG,
+};
+
+struct distro {
+  const char *name;
+  const char *logo; /* the name of its logo in the logo packs */
+  enum pkg_backend pkgs;
+  const char *color; /* of the user@host line */
+};
+
+const struct distro *distro_find(const char *name);
+const char *distro_aliases_unsorted(void);
+
+#endif /* SCREENFETCH_C_DISTROS_H */
@@ -0,0 +1,560 @@
+/*	fields.c
+**	-------------
+**
+**	The field registry. Detectors store plain values (strings, lists, and
+**	integers or reals in the field's unit) and every output renders them in
+**	its own way: there is no preformatted text to parse back.
+**
+**	A value takes eight bytes: numbers are stored inline, while strings and
+**	lists point into a single pool, so fields cost no more than their text.
+**	Each thread works on one set of values at a time, so that batch mode can
+**	detect several systems at once.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+
+/* program includes */
+#include "fields.h"
+#include "detect.h"
+#include "disp.h"
+#include "misc.h"
+#include "render.h"
+#include "util.h"
+
+/* name, key, label, detectors, type, unit, scale, used, total, notes; the keys
+   are part of the machine-readable interface: add new ones, never rename them,
+   and keep the fields of a group next to each other */
+const struct field_def field_defs[N_FIELDS] = {
+    {"user", "user", NULL, DETECT_HOST, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"host", "hostname", NULL, DETECT_HOST, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"os", "os.name", "OS: ", DETECT_DISTRO, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"os.base", "os.base", NULL, DETECT_DISTRO, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"kernel", "kernel", "Kernel: ", DETECT_KERNEL, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"uptime", "uptime_seconds", "Uptime: ", DETECT_UPTIME, FIELD_INTEGER, UNIT_SECONDS, 0, -1, -1,
+     -1},
+    {"pkgs", "packages", "Packages: ", DETECT_PKGS, FIELD_INTEGER, UNIT_NONE, 0, -1, -1, -1},
+    {"cpu", NULL, "CPU: ", DETECT_CPU, FIELD_PROCESSOR, UNIT_NONE, 0, -1, -1, FIELD_CPU_CGROUP},
+    {"cpu.model", "cpu.model", NULL, DETECT_CPU, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"cpu.packages", "cpu.packages", NULL, DETECT_CPU | DETECT_TOPOLOGY, FIELD_INTEGER, UNIT_NONE,
+     0, -1, -1, -1},
+    {"cpu.core_count", "cpu.cores", NULL, DETECT_CPU | DETECT_TOPOLOGY, FIELD_INTEGER, UNIT_NONE,
+     0, -1, -1, -1},
+    {"cpu.thread_count", "cpu.threads", NULL, DETECT_CPU | DETECT_TOPOLOGY, FIELD_INTEGER,
+     UNIT_NONE, 0, -1, -1, -1},
+    {"cpu.max_mhz", "cpu.max_mhz", NULL, DETECT_CPU, FIELD_REAL, UNIT_NONE, 0, -1, -1, -1},
+    {"cpu.topology", NULL, "Topology: ", DETECT_TOPOLOGY, FIELD_LAYOUT, UNIT_NONE, 0, -1, -1, -1},
+    {"cpu.smt", "cpu.smt", NULL, DETECT_TOPOLOGY, FIELD_INTEGER, UNIT_NONE, 0, -1, -1, -1},
+    {"cpu.pcores", "cpu.performance_cores", NULL, DETECT_TOPOLOGY, FIELD_INTEGER, UNIT_NONE, 0, -1,
+     -1, -1},
+    {"cpu.ecores", "cpu.efficiency_cores", NULL, DETECT_TOPOLOGY, FIELD_INTEGER, UNIT_NONE, 0, -1,
+     -1, -1},
+    {"cpu.caches", "cpu.caches", NULL, DETECT_TOPOLOGY, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"cpu.usage", "cpu.usage_percent", "CPU Usage: ", DETECT_CPU_USAGE, FIELD_REAL, UNIT_PERCENT, 0,
+     -1, -1, FIELD_CPU_CORES},
+    {"cpu.cores", NULL, NULL, DETECT_CPU_USAGE, FIELD_LIST, UNIT_NONE, 0, -1, -1, -1},
+    {"cpu.limit", "cpu.limit_cpus", NULL, DETECT_CPU, FIELD_REAL, UNIT_NONE, 0, -1, -1, -1},
+    {"cpu.cpuset", "cpu.cpuset", NULL, DETECT_CPU, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"cpu.cgroup", NULL, NULL, DETECT_CPU, FIELD_LIST, UNIT_NONE, 0, -1, -1, -1},
+    {"pids.limit", "pids_limit", NULL, DETECT_CPU, FIELD_INTEGER, UNIT_NONE, 0, -1, -1, -1},
+    {"gpu", "gpu", "GPU: ", DETECT_GPU, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"shell", "shell", "Shell: ", DETECT_SHELL, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"disk", NULL, "Disk: ", DETECT_DISK, FIELD_USAGE, UNIT_BYTES, 3, FIELD_DISK_USED,
+     FIELD_DISK_TOTAL, FIELD_DISK_MOUNTS},
+    {"disk.used", "disk.used_bytes", NULL, DETECT_DISK, FIELD_INTEGER, UNIT_BYTES, 3, -1, -1, -1},
+    {"disk.total", "disk.total_bytes", NULL, DETECT_DISK, FIELD_INTEGER, UNIT_BYTES, 3, -1, -1, -1},
+    {"disk.mounts", NULL, NULL, DETECT_DISK, FIELD_LIST, UNIT_NONE, 0, -1, -1, -1},
+    {"mem", NULL, "Memory: ", DETECT_MEM, FIELD_USAGE, UNIT_BYTES, 2, FIELD_MEM_USED,
+     FIELD_MEM_TOTAL, FIELD_MEM_CGROUP},
+    {"mem.used", "memory.used_bytes", NULL, DETECT_MEM, FIELD_INTEGER, UNIT_BYTES, 2, -1, -1, -1},
+    {"mem.total", "memory.total_bytes", NULL, DETECT_MEM, FIELD_INTEGER, UNIT_BYTES, 2, -1, -1, -1},
+    {"mem.limit", "memory.limit_bytes", NULL, DETECT_MEM, FIELD_INTEGER, UNIT_BYTES, 2, -1, -1, -1},
+    {"mem.cgroup_used", "memory.cgroup_used_bytes", NULL, DETECT_MEM, FIELD_INTEGER, UNIT_BYTES, 2,
+     -1, -1, -1},
+    {"mem.cgroup", NULL, NULL, DETECT_MEM, FIELD_LIST, UNIT_NONE, 0, -1, -1, -1},
+    {"swap", NULL, "Swap: ", DETECT_MEM, FIELD_USAGE, UNIT_BYTES, 2, FIELD_SWAP_USED,
+     FIELD_SWAP_TOTAL, FIELD_SWAP_EXTRA},
+    {"swap.used", "swap.used_bytes", NULL, DETECT_MEM, FIELD_INTEGER, UNIT_BYTES, 2, -1, -1, -1},
+    {"swap.total", "swap.total_bytes", NULL, DETECT_MEM, FIELD_INTEGER, UNIT_BYTES, 2, -1, -1, -1},
+    {"swap.extra", NULL, NULL, DETECT_MEM, FIELD_LIST, UNIT_NONE, 0, -1, -1, -1},
+    {"res", "resolution", "Resolution: ", DETECT_RES, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"de", "de", "DE: ", DETECT_DE, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"wm", "wm", "WM: ", DETECT_WM, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"wm.theme", "wm_theme", "WM Theme: ", DETECT_WM_THEME, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"gtk", NULL, "GTK: ", DETECT_GTK, FIELD_THEMES, UNIT_NONE, 0, FIELD_GTK2, FIELD_GTK3, -1},
+    {"gtk.gtk2", "gtk_theme.gtk2", NULL, DETECT_GTK, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"gtk.gtk3", "gtk_theme.gtk3", NULL, DETECT_GTK, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"icons", "icon_theme", "Icon Theme: ", DETECT_GTK, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+    {"font", "font", "Font: ", DETECT_GTK, FIELD_STRING, UNIT_NONE, 0, -1, -1, -1},
+};
+
+/* the values detected outside of any other set (see fields_use) */
+static struct fields program_fields;
+static __thread struct fields *cur = &program_fields;
+
+static enum units units = UNITS_IEC;
+
+/*	fields_use
+  makes f the set of values that the calling thread detects into and reads
+  from, or the program's own set if f is NULL; f must start out zeroed
+  returns the set that was in use before
+*/
+struct fields *fields_use(struct fields *f) {
+  struct fields *prev = cur;
+
+  cur = f ? f : &program_fields;
+  return prev;
+}
+
+/*	fields_free
+  releases the memory held by a set of values and empties it
+*/
+void fields_free(struct fields *f) {
+  free(f->pool);
+  memset(f, 0, sizeof(*f));
+}
+
+/*	pool_reserve
+  makes room for len more bytes at the end of the current set's pool
+  returns false if memory ran out
+*/
+static bool pool_reserve(size_t len) {
+  struct fields *f = cur;
+  char *grown;
+  size_t cap = f->pool_cap ? f->pool_cap : 1024;
+
+  if (f->pool_len + len <= f->pool_cap)
+    return true;
+
+  while (f->pool_len + len > cap)
+    cap *= 2;
+
+  if (cap > UINT32_MAX || !(grown = realloc(f->pool, cap))) {
+    ERR_REPORT("Out of memory while storing a detected value.");
+    return false;
+  }
+
+  f->pool = grown;
+  f->pool_cap = cap;
+  return true;
+}
+
+/*	pool_add
+  appends s and its terminator to the pool; s may point into the pool itself
+  returns the offset of the copy, or -1 if memory ran out
+*/
+static long pool_add(const char *s) {
+  struct fields *f = cur;
+  size_t len = strlen(s) + 1, off = f->pool_len;
+  size_t inside = f->pool && s >= f->pool && s < f->pool + f->pool_len ? (size_t)(s - f->pool)
+                                                                       : SIZE_MAX;
+
+  if (!pool_reserve(len))
+    return -1;
+
+  /* growing the pool moves it, and s along with it */
+  if (inside != SIZE_MAX)
+    s = f->pool + inside;
+
+  memmove(f->pool + off, s, len);
+  f->pool_len += len;
+  return (long)off;
+}
+
+/*	field_set_str
+  sets a string field to a copy of s
+*/
+void field_set_str(enum field_id id, const char *s) {
+  long off;
+
+  if ((off = pool_add(s)) < 0)
+    return;
+
+  cur->values[id].text.off = off;
+  cur->values[id].text.len = cur->pool_len - off - 1;
+  cur->set_mask |= (uint64_t)1 << id;
+}
+
+/*	field_printf
+  sets a string field to the printf-style formatted arguments
+*/
+void field_printf(enum field_id id, const char *fmt, ...) {
+  char buf[MAX_STRLEN];
+  va_list args;
+
+  va_start(args, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+
+  field_set_str(id, buf);
+}
+
+/*	field_read_line
+  sets a string field to the next line read from f, if there is one
+  returns false if nothing could be read
+*/
+bool field_read_line(enum field_id id, FILE *f) {
+  char buf[MAX_STRLEN];
+
+  if (!f || !fgets(buf, MAX_STRLEN, f))
+    return false;
+
+  field_set_str(id, buf);
+  return true;
+}
+
+/*	field_set_int
+  sets an integer field, in the field's unit
+*/
+void field_set_int(enum field_id id, long long value) {
+  cur->values[id].integer = value;
+  cur->set_mask |= (uint64_t)1 << id;
+}
+
+/*	field_set_real
+  sets a real field, in the field's unit
+*/
+void field_set_real(enum field_id id, double value) {
+  cur->values[id].real = value;
+  cur->set_mask |= (uint64_t)1 << id;
+}
+
+/*	field_list_add
+  appends a copy of item to a list field
+*/
+void field_list_add(enum field_id id, const char *item) {
+  union field_value *v = &cur->values[id];
+  const char *end;
+  size_t size;
+  long off;
+
+  if (!field_isset(id) || v->text.len == 0) {
+    if ((off = pool_add(item)) < 0)
+      return;
+    v->text.off = off;
+    v->text.len = 1;
+    cur->set_mask |= (uint64_t)1 << id;
+    return;
+  }
+
+  /* the items must stay contiguous, so move the list to the end of the pool if
+     something has been stored after it */
+  for (end = cur->pool + v->text.off, off = v->text.len; off > 0; off--)
+    end += strlen(end) + 1;
+
+  if (end != cur->pool + cur->pool_len) {
+    size = end - (cur->pool + v->text.off);
+    if (!pool_reserve(size))
+      return;
+    memcpy(cur->pool + cur->pool_len, cur->pool + v->text.off, size);
+    v->text.off = cur->pool_len;
+    cur->pool_len += size;
+  }
+
+  if (pool_add(item) >= 0)
+    v->text.len++;
+}
+
+/*	field_clear
+  marks a field as undetected again
+*/
+void field_clear(enum field_id id) {
+  cur->set_mask &= ~((uint64_t)1 << id);
+}
+
+/*	field_isset
+  returns true if the field has been detected
+*/
+bool field_isset(enum field_id id) {
+  return cur->set_mask & ((uint64_t)1 << id);
+}
+
+/*	field_str
+  returns a string field's value, or "Unknown" if undetected; the pointer is
+  only valid until the next field is set
+*/
+const char *field_str(enum field_id id) {
+  return field_isset(id) ? cur->pool + cur->values[id].text.off : "Unknown";
+}
+
+/*	field_int
+  returns an integer field's value, or -1 if undetected
+*/
+long long field_int(enum field_id id) {
+  return field_isset(id) ? cur->values[id].integer : -1;
+}
+
+/*	field_real
+  returns a real field's value, or -1 if undetected
+*/
+double field_real(enum field_id id) {
+  return field_isset(id) ? cur->values[id].real : -1;
+}
+
+/*	field_list_next
+  walks a list field: returns its first item if item is NULL, otherwise the
+  one after item, or NULL past the last one
+*/
+const char *field_list_next(enum field_id id, const char *item) {
+  const char *first = cur->pool + cur->values[id].text.off, *end;
+  uint32_t i;
+
+  if (!field_isset(id) || cur->values[id].text.len == 0)
+    return NULL;
+
+  if (!item)
+    return first;
+
+  for (end = first, i = 0; i < cur->values[id].text.len; i++)
+    end += strlen(end) + 1;
+
+  item += strlen(item) + 1;
+  return item < end ? item : NULL;
+}
+
+/*	fields_set_units
+  chooses how byte counts are rendered
+*/
+void fields_set_units(enum units u) {
+  units = u;
+}
+
+/*	fields_format_bytes
+  formats a byte count in the unit of the given scale
+*/
+void fields_format_bytes(char *buf, size_t size, long long bytes, unsigned int scale) {
+  static const char *const iec[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  static const char *const si[] = {"B", "kB", "MB", "GB", "TB"};
+  long long div = 1;
+  unsigned int i;
+
+  if (scale > 4)
+    scale = 4;
+
+  for (i = 0; i < scale; i++)
+    div *= units == UNITS_SI ? 1000 : 1024;
+
+  snprintf(buf, size, "%lld%s", bytes / div, units == UNITS_SI ? si[scale] : iec[scale]);
+}
+
+/*	format_number
+  formats an integer field's value in its unit
+*/
+static void format_number(char *buf, size_t size, const struct field_def *def, long long value) {
+  unsigned int secs, mins, hrs, days;
+
+  switch (def->unit) {
+  case UNIT_BYTES:
+    fields_format_bytes(buf, size, value, def->scale);
+    break;
+  case UNIT_SECONDS:
+    split_uptime(value, &secs, &mins, &hrs, &days);
+    if (days > 0)
+      snprintf(buf, size, "%ud %uh %um %us", days, hrs, mins, secs);
+    else
+      snprintf(buf, size, "%uh %um %us", hrs, mins, secs);
+    break;
+  case UNIT_PERCENT:
+    snprintf(buf, size, "%lld%%", value);
+    break;
+  default:
+    snprintf(buf, size, "%lld", value);
+  }
+}
+
+/*	append_list
+  appends a list's items, separated by commas
+*/
+static void append_list(enum field_id id) {
+  const char *first = field_list_next(id, NULL), *item;
+
+  for (item = first; item; item = field_list_next(id, item)) {
+    if (item != first)
+      frame_append(", ");
+    frame_append(item);
+  }
+}
+
+/*	append_usage
+  appends "used / total (percent)", just the total if that is all there is,
+  or "None" if the total is zero
+*/
+static void append_usage(const struct field_def *def) {
+  long long used = field_int(def->used), total = field_int(def->total);
+  char num[64];
+
+  if (total < 0) {
+    frame_append("Unknown");
+    return;
+  }
+
+  /* some platforms only know the total */
+  if (used < 0) {
+    format_number(num, sizeof(num), def, total);
+    frame_append(num);
+    return;
+  }
+
+  if (total == 0) {
+    frame_append("None");
+    return;
+  }
+
+  format_number(num, sizeof(num), def, used);
+  frame_append(num);
+  frame_append(" / ");
+  format_number(num, sizeof(num), def, total);
+  frame_append(num);
+  snprintf(num, sizeof(num), " (%lld%%)", used * 100 / total);
+  frame_append(num);
+}
+
+/*	append_themes
+  appends the GTK2 and GTK3 themes, each marked with its version (once if
+  they are the same), or "Unknown" if neither is known
+*/
+static void append_themes(const struct field_def *def) {
+  bool gtk2 = field_isset(def->used), gtk3 = field_isset(def->total);
+
+  if (gtk2 && gtk3 && STREQ(field_str(def->used), field_str(def->total))) {
+    frame_append(field_str(def->used));
+    frame_append(" (GTK2/3)");
+    return;
+  }
+
+  if (gtk2) {
+    frame_append(field_str(def->used));
+    frame_append(gtk3 ? " (GTK2), " : " (GTK2)");
+  }
+
+  if (gtk3) {
+    frame_append(field_str(def->total));
+    frame_append(" (GTK3)");
+  }
+
+  if (!gtk2 && !gtk3)
+    frame_append("Unknown");
+}
+
+/*	append_processor
+  appends "[Nx ]model (xC/yT) @ z.zzGHz", leaving out the parts that are
+  unknown, or "Unknown" without a model
+*/
+static void append_processor(void) {
+  char buf[64];
+
+  if (!field_isset(FIELD_CPU_MODEL)) {
+    frame_append("Unknown");
+    return;
+  }
+
+  if (field_int(FIELD_CPU_PACKAGES) > 1) {
+    snprintf(buf, sizeof(buf), "%lldx ", field_int(FIELD_CPU_PACKAGES));
+    frame_append(buf);
+  }
+
+  frame_append(field_str(FIELD_CPU_MODEL));
+
+  if (field_isset(FIELD_CPU_CORE_COUNT) && field_isset(FIELD_CPU_THREAD_COUNT)) {
+    snprintf(buf, sizeof(buf), " (%lldC/%lldT)", field_int(FIELD_CPU_CORE_COUNT),
+             field_int(FIELD_CPU_THREAD_COUNT));
+    frame_append(buf);
+  }
+
+  if (field_real(FIELD_CPU_MHZ) > 0) {
+    snprintf(buf, sizeof(buf), " @ %.2fGHz", field_real(FIELD_CPU_MHZ) / 1000);
+    frame_append(buf);
+  }
+}
+
+/*	append_layout
+  appends "xS/yC/zT (SMTn) pP+eE, caches", leaving out the parts that are
+  unknown or trivial, or "Unknown" without the counts
+*/
+static void append_layout(void) {
+  char buf[64];
+
+  if (!field_isset(FIELD_CPU_PACKAGES) || !field_isset(FIELD_CPU_CORE_COUNT) ||
+      !field_isset(FIELD_CPU_THREAD_COUNT)) {
+    frame_append("Unknown");
+    return;
+  }
+
+  snprintf(buf, sizeof(buf), "%lldS/%lldC/%lldT", field_int(FIELD_CPU_PACKAGES),
+           field_int(FIELD_CPU_CORE_COUNT), field_int(FIELD_CPU_THREAD_COUNT));
+  frame_append(buf);
+
+  if (field_int(FIELD_CPU_SMT) > 1) {
+    snprintf(buf, sizeof(buf), " (SMT%lld)", field_int(FIELD_CPU_SMT));
+    frame_append(buf);
+  }
+
+  if (field_int(FIELD_CPU_PCORES) > 0 && field_int(FIELD_CPU_ECORES) > 0) {
+    snprintf(buf, sizeof(buf), " %lldP+%lldE", field_int(FIELD_CPU_PCORES),
+             field_int(FIELD_CPU_ECORES));
+    frame_append(buf);
+  }
+
+  if (field_isset(FIELD_CPU_CACHES)) {
+    frame_append(", ");
+    frame_append(field_str(FIELD_CPU_CACHES));
+  }
+}
+
+/*	field_append
+  appends a field, as it is shown to people, to the output frame
+*/
+void field_append(enum field_id id) {
+  const struct field_def *def = &field_defs[id];
+  char num[64];
+
+  switch (def->type) {
+  case FIELD_USAGE:
+    append_usage(def);
+    break;
+  case FIELD_THEMES:
+    append_themes(def);
+    break;
+  case FIELD_PROCESSOR:
+    append_processor();
+    break;
+  case FIELD_LAYOUT:
+    append_layout();
+    break;
+  case FIELD_LIST:
+    append_list(id);
+    break;
+  case FIELD_STRING:
+    frame_append(field_str(id));
+    break;
+  case FIELD_INTEGER:
+    if (!field_isset(id)) {
+      frame_append("Unknown");
+      return;
+    }
+    format_number(num, sizeof(num), def, cur->values[id].integer);
+    frame_append(num);
+    break;
+  case FIELD_REAL:
+    if (!field_isset(id)) {
+      frame_append("Unknown");
+      return;
+    }
+    snprintf(num, sizeof(num), def->unit == UNIT_PERCENT ? "%.0f%%" : "%g",
+             cur->values[id].real);
+    frame_append(num);
+    break;
+  }
+
+  if (def->notes >= 0 && field_list_next(def->notes, NULL)) {
+    frame_append(" [");
+    append_list(def->notes);
+    frame_append("]");
+  }
+}
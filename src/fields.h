@@ -0,0 +1,145 @@
+/*	fields.h
+**	-------------
+**
+**	The field registry: the ids, types and units of everything screenfetch-c
+**	detects, and the functions to set, read and render them.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_FIELDS_H
+#define SCREENFETCH_C_FIELDS_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+enum field_id {
+  FIELD_USER,
+  FIELD_HOSTNAME,
+  FIELD_OS,
+  FIELD_OS_BASE, /* the known distro a derivative takes its logo and packages from */
+  FIELD_KERNEL,
+  FIELD_UPTIME,
+  FIELD_PKGS,
+  FIELD_CPU,
+  FIELD_CPU_MODEL,
+  FIELD_CPU_PACKAGES,
+  FIELD_CPU_CORE_COUNT,
+  FIELD_CPU_THREAD_COUNT,
+  FIELD_CPU_MHZ,
+  FIELD_TOPOLOGY,
+  FIELD_CPU_SMT,
+  FIELD_CPU_PCORES,
+  FIELD_CPU_ECORES,
+  FIELD_CPU_CACHES,
+  FIELD_CPU_USAGE,
+  FIELD_CPU_CORES,
+  FIELD_CPU_LIMIT,
+  FIELD_CPU_CPUSET,
+  FIELD_CPU_CGROUP,
+  FIELD_PIDS_LIMIT,
+  FIELD_GPU,
+  FIELD_SHELL,
+  FIELD_DISK,
+  FIELD_DISK_USED,
+  FIELD_DISK_TOTAL,
+  FIELD_DISK_MOUNTS,
+  FIELD_MEM,
+  FIELD_MEM_USED,
+  FIELD_MEM_TOTAL,
+  FIELD_MEM_LIMIT,
+  FIELD_MEM_CGROUP_USED,
+  FIELD_MEM_CGROUP,
+  FIELD_SWAP,
+  FIELD_SWAP_USED,
+  FIELD_SWAP_TOTAL,
+  FIELD_SWAP_EXTRA,
+  FIELD_RES,
+  FIELD_DE,
+  FIELD_WM,
+  FIELD_WM_THEME,
+  FIELD_GTK,
+  FIELD_GTK2,
+  FIELD_GTK3,
+  FIELD_ICONS,
+  FIELD_FONT,
+  N_FIELDS
+};
+
+enum field_type {
+  FIELD_STRING,
+  FIELD_INTEGER, /* long long, in the field's unit */
+  FIELD_REAL,    /* double, in the field's unit */
+  FIELD_LIST,    /* any number of strings */
+  FIELD_USAGE,   /* no value of its own: "used / total (percent)" of two other fields */
+  FIELD_THEMES,  /* no value of its own: the GTK2 and GTK3 themes of two other fields */
+  FIELD_PROCESSOR, /* no value of its own: the CPU's model, counts and clock */
+  FIELD_LAYOUT,    /* no value of its own: the CPU's counts, core types and caches */
+};
+
+enum field_unit {
+  UNIT_NONE,
+  UNIT_BYTES,
+  UNIT_SECONDS,
+  UNIT_PERCENT,
+};
+
+/* how byte counts are shown: powers of 1024 (MiB) or of 1000 (MB) */
+enum units {
+  UNITS_IEC,
+  UNITS_SI,
+};
+
+struct field_def {
+  const char *name;  /* the --format name */
+  const char *key;   /* the machine-readable key, as group.key; NULL if not exported */
+  const char *label; /* the label of its row in the normal output */
+  unsigned int detectors; /* the DETECT_* bits that set it */
+  unsigned char type;     /* enum field_type */
+  unsigned char unit;     /* enum field_unit */
+  unsigned char scale;    /* bytes are shown in units of 1024^scale (or 1000^scale) */
+  signed char used, total; /* the parts of a FIELD_USAGE (or GTK2 and GTK3), or -1 */
+  signed char notes;       /* a list shown in brackets after the value, or -1 */
+};
+
+extern const struct field_def field_defs[N_FIELDS];
+
+union field_value {
+  long long integer;
+  double real;
+  struct {
+    uint32_t off; /* into the pool */
+    uint32_t len; /* the string's length, or the list's item count */
+  } text;
+};
+
+/* one run's detected values; only touched through the functions below */
+struct fields {
+  union field_value values[N_FIELDS];
+  uint64_t set_mask;
+  char *pool; /* every string and list item, NUL-terminated; a list's items are contiguous */
+  size_t pool_len, pool_cap;
+};
+
+struct fields *fields_use(struct fields *f);
+void fields_free(struct fields *f);
+
+void field_set_str(enum field_id id, const char *s);
+void field_printf(enum field_id id, const char *fmt, ...);
+void field_set_int(enum field_id id, long long value);
+void field_set_real(enum field_id id, double value);
+bool field_read_line(enum field_id id, FILE *f);
+void field_list_add(enum field_id id, const char *item);
+void field_clear(enum field_id id);
+
+bool field_isset(enum field_id id);
+const char *field_str(enum field_id id);
+long long field_int(enum field_id id);
+double field_real(enum field_id id);
+const char *field_list_next(enum field_id id, const char *item);
+
+void fields_set_units(enum units units);
+void fields_format_bytes(char *buf, size_t size, long long bytes, unsigned int scale);
+void field_append(enum field_id id);
+
+#endif /* SCREENFETCH_C_FIELDS_H */
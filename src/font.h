@@ -0,0 +1,18 @@
+/*	font.h
+**	-------------
+**
+**	The size of the bitmap font in font.c, and its lookup function.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_FONT_H
+#define SCREENFETCH_C_FONT_H
+
+#include <stdint.h>
+
+#define FONT_WIDTH 5
+#define FONT_HEIGHT 9
+
+const unsigned char *font_glyph(uint32_t cp);
+
+#endif /* SCREENFETCH_C_FONT_H */
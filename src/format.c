@@ -0,0 +1,178 @@
+/*	format.c
+**	-------------
+**
+**	Output templates (--format '{user}@{host} | {cpu} | {mem.used}/{mem.total}').
+**	A template is compiled once into a list of literal spans and field
+**	references, which also tells main() which detectors it needs, and is
+**	then rendered with straight appends to the output frame.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* program includes */
+#include "format.h"
+#include "fields.h"
+#include "disp.h"
+#include "misc.h"
+#include "render.h"
+
+/*	format_field_lookup
+  returns the field the len-byte name at name refers to, or -1; a ".bytes"
+  or ".seconds" suffix asks for a field's plain value rather than its
+  display form, and sets *raw
+*/
+static int format_field_lookup(const char *name, size_t len, bool *raw) {
+  static const char *const suffixes[] = {".bytes", ".seconds"};
+  const char *field;
+  size_t i, n;
+  int id;
+
+  *raw = false;
+
+  for (id = 0; id < N_FIELDS; id++) {
+    field = field_defs[id].name;
+    if (strlen(field) == len && !strncmp(field, name, len))
+      return id;
+  }
+
+  for (i = 0; i < sizeof(suffixes) / sizeof(suffixes[0]); i++) {
+    n = strlen(suffixes[i]);
+    if (len <= n || strncmp(name + len - n, suffixes[i], n))
+      continue;
+
+    if ((id = format_field_lookup(name, len - n, raw)) >= 0 && !*raw &&
+        field_defs[id].type == FIELD_INTEGER &&
+        field_defs[id].unit == (i == 0 ? UNIT_BYTES : UNIT_SECONDS)) {
+      *raw = true;
+      return id;
+    }
+  }
+
+  return -1;
+}
+
+/*	format_add
+  appends an op to f
+  returns false if memory ran out
+*/
+static bool format_add(struct format *f, size_t *cap, unsigned int start, unsigned int len,
+                       int field, bool raw) {
+  struct format_op *grown;
+
+  /* empty literal spans are dropped, so rendering never appends nothing */
+  if (field == FORMAT_LITERAL && len == 0)
+    return true;
+
+  if (f->n_ops == *cap) {
+    *cap = *cap ? *cap * 2 : 8;
+    if (!(grown = realloc(f->ops, *cap * sizeof(*grown))))
+      return false;
+    f->ops = grown;
+  }
+
+  f->ops[f->n_ops].start = start;
+  f->ops[f->n_ops].len = len;
+  f->ops[f->n_ops].field = field;
+  f->ops[f->n_ops].raw = raw;
+  f->n_ops++;
+  return true;
+}
+
+/*	format_compile
+  parses tmpl into f: text is copied as is, {name} is replaced by a field
+  and {{ and }} stand for literal braces
+  returns false (after reporting the problem) if the template is invalid
+*/
+bool format_compile(const char *tmpl, struct format *f) {
+  char msg[MAX_STRLEN];
+  const char *p = tmpl, *lit = tmpl, *close;
+  size_t cap = 0;
+  bool raw;
+  int field;
+
+  f->src = tmpl;
+  f->ops = NULL;
+  f->n_ops = 0;
+  f->detectors = 0;
+
+  while (*p) {
+    if ((p[0] == '{' && p[1] == '{') || (p[0] == '}' && p[1] == '}')) {
+      /* keep the first brace with the text before it, skip the second */
+      if (!format_add(f, &cap, lit - tmpl, p + 1 - lit, FORMAT_LITERAL, false))
+        goto oom;
+      lit = p += 2;
+    } else if (*p == '{') {
+      if (!(close = strchr(p, '}'))) {
+        ERR_REPORT("Unterminated {field} in the format template.");
+        goto fail;
+      }
+
+      if ((field = format_field_lookup(p + 1, close - p - 1, &raw)) < 0) {
+        snprintf(msg, MAX_STRLEN, "Unknown field {%.*s} in the format template.",
+                 (int)(close - p - 1), p + 1);
+        ERR_REPORT(msg);
+        goto fail;
+      }
+
+      if (!format_add(f, &cap, lit - tmpl, p - lit, FORMAT_LITERAL, false) ||
+          !format_add(f, &cap, 0, 0, field, raw))
+        goto oom;
+
+      f->detectors |= field_defs[field].detectors;
+      lit = p = close + 1;
+    } else {
+      p++;
+    }
+  }
+
+  if (!format_add(f, &cap, lit - tmpl, p - lit, FORMAT_LITERAL, false))
+    goto oom;
+
+  return true;
+
+oom:
+  ERR_REPORT("Out of memory while compiling the format template.");
+fail:
+  format_free(f);
+  return false;
+}
+
+/*	format_render
+  appends the template, with every field filled in, and a newline to the
+  output frame
+*/
+void format_render(const struct format *f) {
+  char num[64];
+  size_t i;
+
+  for (i = 0; i < f->n_ops; i++) {
+    if (f->ops[i].field == FORMAT_LITERAL) {
+      frame_append_n(f->src + f->ops[i].start, f->ops[i].len);
+    } else if (!f->ops[i].raw) {
+      field_append(f->ops[i].field);
+    } else if (field_isset(f->ops[i].field)) {
+      snprintf(num, sizeof(num), "%lld", field_int(f->ops[i].field));
+      frame_append(num);
+    } else {
+      frame_append("Unknown");
+    }
+  }
+
+  frame_append("\n");
+
+  return;
+}
+
+/*	format_free
+  releases the compiled ops of f
+*/
+void format_free(struct format *f) {
+  free(f->ops);
+  f->ops = NULL;
+  f->n_ops = 0;
+}
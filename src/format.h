@@ -0,0 +1,35 @@
+/*	format.h
+**	-------------
+**
+**	Function prototypes and types for format.c, the --format templates.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_FORMAT_H
+#define SCREENFETCH_C_FORMAT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* one step of a compiled template: a span of the template's own text, or a
+   field reference */
+struct format_op {
+  unsigned int start, len; /* the literal span, if field is FORMAT_LITERAL */
+  int field;
+  bool raw; /* the field's plain value rather than its display form */
+};
+
+#define FORMAT_LITERAL -1
+
+struct format {
+  const char *src;
+  struct format_op *ops;
+  size_t n_ops;
+  unsigned int detectors; /* the DETECT_* bits the referenced fields need */
+};
+
+bool format_compile(const char *tmpl, struct format *f);
+void format_render(const struct format *f);
+void format_free(struct format *f);
+
+#endif /* SCREENFETCH_C_FORMAT_H */
@@ -0,0 +1,54 @@
+/*	logopack.h
+**	-------------
+**
+**	The layout of a logo pack, shared by the generator (src/tools/logopack.c)
+**	and the loader in logos.c.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_LOGOPACK_H
+#define SCREENFETCH_C_LOGOPACK_H
+
+/* a pack is, with every integer little-endian and unaligned:
+
+     header   magic[8] = LOGOPACK_MAGIC, u32 n_logos, u32 pack size
+     entries  n_logos entries, sorted by name in strcmp() order:
+                u32 name offset, u32 data offset, u32 data length,
+                u16 line count, u16 widest line, u8 colors[3], u8 unused
+     names    NUL-terminated
+     data     per logo: u16 width of each line, then each line NUL-terminated,
+              with every color escape replaced by a single token byte
+
+   all offsets are from the start of the pack */
+#define LOGOPACK_MAGIC "SFCLOGO1"
+#define LOGOPACK_HEADER_SIZE 16
+#define LOGOPACK_ENTRY_SIZE 20
+
+/* a color escape is stored as LOGOPACK_TOKEN + its index in the table below;
+   the range avoids tabs, newlines and everything printable */
+#define LOGOPACK_TOKEN 0x0E
+#define LOGOPACK_N_COLORS 17
+
+#define LOGOPACK_IS_TOKEN(c) ((c) >= LOGOPACK_TOKEN && (c) < LOGOPACK_TOKEN + LOGOPACK_N_COLORS)
+
+/* X(name) for every color in colors.h, in token order */
+#define LOGOPACK_COLORS(X) \
+  X(TNRM) \
+  X(TBLK) \
+  X(TRED) \
+  X(TGRN) \
+  X(TBRN) \
+  X(TBLU) \
+  X(TPUR) \
+  X(TCYN) \
+  X(TLGY) \
+  X(TDGY) \
+  X(TLRD) \
+  X(TLGN) \
+  X(TYLW) \
+  X(TLBL) \
+  X(TLPR) \
+  X(TLCY) \
+  X(TWHT)
+
+#endif /* SCREENFETCH_C_LOGOPACK_H */
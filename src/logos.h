@@ -2,53 +2,23 @@
 **	Author: William Woodruff
 **	-------------
 **
-**	The ASCII logos used by screenfetch-c are externalized in this file.
+**	The ASCII logos used by screenfetch-c, as expanded from a logo pack.
 **	Like the rest of screenfetch-c, this file is licensed under the MIT license.
 */
 
 #ifndef SCREENFETCH_C_LOGOS_H
 #define SCREENFETCH_C_LOGOS_H
 
-extern char *oldarch_logo[];
-extern char *arch_logo[];
-extern char *mint_logo[];
-extern char *lmde_logo[];
-extern char *ubuntu_logo[];
-extern char *debian_logo[];
-extern char *crunchbang_logo[];
-extern char *gentoo_logo[];
-extern char *funtoo_logo[];
-extern char *fedora_logo[];
-extern char *freebsd_logo[];
-extern char *openbsd_logo[];
-extern char *dragonflybsd_logo[];
-extern char *netbsd_logo[];
-extern char *mandriva_mandrake_logo[];
-extern char *opensuse_logo[];
-extern char *slackware_logo[];
-extern char *redhat_logo[];
-extern char *frugalware_logo[];
-extern char *peppermint_logo[];
-extern char *solusos_logo[];
-extern char *mageia_logo[];
-extern char *parabolagnu_linuxlibre_logo[];
-extern char *viperr_logo[];
-extern char *linuxdeepin_logo[];
-extern char *chakra_logo[];
-extern char *fuduntu_logo[];
-extern char *macosx_logo[];
-extern char *windows_logo[];
-extern char *windows_modern_logo[];
-extern char *trisquel_logo[];
-extern char *manjaro_logo[];
-extern char *elementaryos_logo[];
-extern char *scientificlinux_logo[];
-extern char *backtracklinux_logo[];
-extern char *kalilinux_logo[];
-extern char *sabayon_logo[];
-extern char *android_logo[];
-extern char *linux_logo[];
-extern char *solaris_logo[];
-extern char *angstrom_logo[];
+/* a logo, its length and the number of columns each line takes up on screen
+   (escapes excluded, UTF-8 counted per character), as measured at build time */
+struct logo {
+  char **lines;
+  const unsigned short int *widths;
+  unsigned short int n_lines;
+  unsigned short int width; /* of the widest line */
+  const char *col1, *col2, *col3;
+};
+
+const struct logo *logo_find(const char *name);
 
 #endif /* SCREENFETCH_C_LOGOS_H */
@@ -0,0 +1,457 @@
+/*	machine.c
+**	-------------
+**
+**	The machine-readable output modes (--output json, kv and prometheus).
+**	Every field is written under a stable key, with sizes in bytes and times
+**	in seconds, straight from the detected values: no logo, no colors.
+**	Batch mode writes a record per root, as a table row or a JSON line.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if !defined(__MINGW32__)
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+/* program includes */
+#include "machine.h"
+#include "fields.h"
+#include "detect.h"
+#include "util.h"
+#include "misc.h"
+#include "disp.h"
+#include "render.h"
+
+/* the Prometheus textfile-collector metrics: one info metric per group of
+   labels, and one gauge per number, named after the field's key */
+struct label {
+  const char *group;
+  const char *key;
+  enum field_id field;
+};
+
+static const struct label prom_labels[] = {
+    {"os", "name", FIELD_OS},        {"os", "base", FIELD_OS_BASE},
+    {"os", "kernel", FIELD_KERNEL},  {"cpu", "model", FIELD_CPU_MODEL},
+    {"gpu", "model", FIELD_GPU},
+};
+
+struct metric_help {
+  const char *name;
+  const char *help;
+};
+
+static const struct metric_help prom_infos[] = {
+    {"os", "Operating system and kernel."},
+    {"cpu", "CPU model."},
+    {"gpu", "GPU model."},
+};
+
+struct gauge {
+  enum field_id field;
+  const char *help;
+};
+
+static const struct gauge prom_gauges[] = {
+    {FIELD_UPTIME, "Time since the system booted."},
+    {FIELD_PKGS, "Number of installed packages."},
+    {FIELD_CPU_PACKAGES, "Number of CPU packages (sockets)."},
+    {FIELD_CPU_CORE_COUNT, "Number of physical CPU cores."},
+    {FIELD_CPU_THREAD_COUNT, "Number of hardware threads."},
+    {FIELD_CPU_MHZ, "Highest CPU clock, in MHz."},
+    {FIELD_MEM_USED, "Memory in use."},
+    {FIELD_MEM_TOTAL, "Total memory."},
+    {FIELD_MEM_LIMIT, "Memory limit of the cgroup."},
+    {FIELD_MEM_CGROUP_USED, "Memory in use by the cgroup."},
+    {FIELD_CPU_LIMIT, "CPU bandwidth limit of the cgroup, in CPUs."},
+    {FIELD_PIDS_LIMIT, "Task limit of the cgroup."},
+    {FIELD_SWAP_USED, "Swap in use."},
+    {FIELD_SWAP_TOTAL, "Total swap."},
+    {FIELD_DISK_USED, "Disk space in use, across local filesystems."},
+    {FIELD_DISK_TOTAL, "Total disk space, across local filesystems."},
+};
+
+#define PROM_PREFIX "screenfetch_"
+#define PROM_FILE "screenfetch_c.prom"
+
+enum escape_style {
+  ESCAPE_JSON,       /* \", \\ and control characters as \n or \u00XX */
+  ESCAPE_KV,         /* \\ and control characters as \n or \xXX */
+  ESCAPE_PROMETHEUS, /* \", \\ and \n only */
+};
+
+/*	field_value
+  formats a numeric field's plain value into buf
+  returns buf, or NULL if the field is not numeric or undetected
+*/
+static const char *field_value(enum field_id id, char *buf, size_t size) {
+  if (!field_isset(id))
+    return NULL;
+
+  switch (field_defs[id].type) {
+  case FIELD_INTEGER:
+    snprintf(buf, size, "%lld", field_int(id));
+    return buf;
+  case FIELD_REAL:
+    snprintf(buf, size, "%g", field_real(id));
+    return buf;
+  default:
+    break;
+  }
+
+  return NULL;
+}
+
+/*	field_string
+  returns a string field's value, or NULL if it is not a string or undetected
+*/
+static const char *field_string(enum field_id id) {
+  if (field_defs[id].type != FIELD_STRING || !field_isset(id) || !*field_str(id))
+    return NULL;
+
+  return field_str(id);
+}
+
+/*	key_split
+  splits a field's key at its dot
+  returns the length of its group, or 0 for a top-level field
+*/
+static size_t key_split(const char *key) {
+  const char *dot = strchr(key, '.');
+
+  return dot ? (size_t)(dot - key) : 0;
+}
+
+/*	needs_escape
+  returns true if c has to be escaped in the given output format
+*/
+static bool needs_escape(unsigned char c, enum escape_style style) {
+  if (c == '\\' || c == '\n')
+    return true;
+  if (c == '"')
+    return style != ESCAPE_KV;
+
+  return style != ESCAPE_PROMETHEUS && (c < 0x20 || c == 0x7f);
+}
+
+/*	append_escaped
+  appends s with the backslash escapes its output format calls for
+*/
+static void append_escaped(const char *s, enum escape_style style) {
+  const char *run = s;
+  char esc[8];
+
+  for (; *s; s++) {
+    if (!needs_escape(*s, style))
+      continue;
+
+    frame_append_n(run, s - run);
+    run = s + 1;
+
+    switch (*s) {
+    case '\n':
+      frame_append("\\n");
+      break;
+    case '\t':
+      frame_append("\\t");
+      break;
+    case '\r':
+      frame_append("\\r");
+      break;
+    case '"':
+    case '\\':
+      snprintf(esc, sizeof(esc), "\\%c", *s);
+      frame_append(esc);
+      break;
+    default:
+      snprintf(esc, sizeof(esc), style == ESCAPE_JSON ? "\\u%04x" : "\\x%02x",
+               (unsigned char)*s);
+      frame_append(esc);
+    }
+  }
+
+  frame_append_n(run, s - run);
+}
+
+/*	json_object
+  outputs the fields set by the given detectors as a JSON object, grouped
+  fields as nested objects, with null for anything undetected; led by the
+  root they were detected under, if there is one, and either indented or
+  on a single line
+*/
+static void json_object(const char *root, unsigned int detectors, bool pretty) {
+  const char *group = NULL, *key, *str;
+  size_t group_len = 0, len;
+  bool first = true;
+  char num[64];
+  int i;
+
+  frame_append("{");
+
+  if (root) {
+    frame_append(pretty ? "\n  \"root\": \"" : "\"root\": \"");
+    append_escaped(root, ESCAPE_JSON);
+    frame_append("\"");
+    first = false;
+  }
+
+  for (i = 0; i < N_FIELDS; i++) {
+    if (!(key = field_defs[i].key) || !(field_defs[i].detectors & detectors))
+      continue;
+
+    len = key_split(key);
+
+    /* close the previous group if this field is not part of it */
+    if (group && (len != group_len || strncmp(group, key, len))) {
+      frame_append(pretty ? "\n  }" : "}");
+      group = NULL;
+    }
+
+    if (pretty)
+      frame_append(first ? "\n" : ",\n");
+    else if (!first)
+      frame_append(", ");
+    first = false;
+
+    if (len && !group) {
+      group = key;
+      group_len = len;
+      frame_append(pretty ? "  \"" : "\"");
+      frame_append_n(group, group_len);
+      frame_append(pretty ? "\": {\n" : "\": {");
+    }
+
+    frame_append(!pretty ? "\"" : group ? "    \"" : "  \"");
+    frame_append(len ? key + len + 1 : key);
+    frame_append("\": ");
+
+    if ((str = field_string(i))) {
+      frame_append("\"");
+      append_escaped(str, ESCAPE_JSON);
+      frame_append("\"");
+    } else if ((str = field_value(i, num, sizeof(num)))) {
+      frame_append(str);
+    } else {
+      frame_append("null");
+    }
+  }
+
+  if (pretty)
+    frame_append(group ? "\n  }\n}\n" : "\n}\n");
+  else
+    frame_append(group ? "}}\n" : "}\n");
+}
+
+/*	main_json_output
+  outputs every field as a JSON object, grouped fields as nested objects,
+  with null for anything undetected
+*/
+void main_json_output(void) {
+  json_object(NULL, DETECT_ALL, true);
+
+  return;
+}
+
+/*	record_json_output
+  outputs the fields set by the given detectors under root as a JSON object
+  on a single line, one record of a JSON Lines stream
+*/
+void record_json_output(const char *root, unsigned int detectors) {
+  json_object(root, detectors, false);
+
+  return;
+}
+
+/*	record_table_header
+  outputs the header line of a table of the fields set by the given
+  detectors, one root per row
+*/
+void record_table_header(unsigned int detectors) {
+  int i;
+
+  frame_append("root");
+
+  for (i = 0; i < N_FIELDS; i++) {
+    if (field_defs[i].key && field_defs[i].detectors & detectors) {
+      frame_append("\t");
+      frame_append(field_defs[i].key);
+    }
+  }
+
+  frame_append("\n");
+
+  return;
+}
+
+/*	record_table_output
+  outputs the fields set by the given detectors under root as a row of
+  tab-separated values, with - for anything undetected
+*/
+void record_table_output(const char *root, unsigned int detectors) {
+  const char *str;
+  char num[64];
+  int i;
+
+  append_escaped(root, ESCAPE_KV);
+
+  for (i = 0; i < N_FIELDS; i++) {
+    if (!field_defs[i].key || !(field_defs[i].detectors & detectors))
+      continue;
+
+    frame_append("\t");
+
+    if ((str = field_string(i)))
+      append_escaped(str, ESCAPE_KV);
+    else if ((str = field_value(i, num, sizeof(num))))
+      frame_append(str);
+    else
+      frame_append("-");
+  }
+
+  frame_append("\n");
+
+  return;
+}
+
+/*	main_kv_output
+  outputs every field as a key=value line, grouped fields as group.key,
+  with an empty value for anything undetected
+*/
+void main_kv_output(void) {
+  const char *str;
+  char num[64];
+  int i;
+
+  for (i = 0; i < N_FIELDS; i++) {
+    if (!field_defs[i].key)
+      continue;
+
+    frame_append(field_defs[i].key);
+    frame_append("=");
+
+    if ((str = field_string(i)))
+      append_escaped(str, ESCAPE_KV);
+    else if ((str = field_value(i, num, sizeof(num))))
+      frame_append(str);
+
+    frame_append("\n");
+  }
+
+  return;
+}
+
+/*	main_prometheus_output
+  outputs the info metrics and gauges in the Prometheus text format,
+  leaving out gauges whose value is undetected
+*/
+void main_prometheus_output(void) {
+  char name[MAX_STRLEN], *c;
+  const char *str;
+  char num[64];
+  size_t i, j;
+
+  for (i = 0; i < sizeof(prom_labels) / sizeof(prom_labels[0]); i++) {
+    if (i == 0 || !STREQ(prom_labels[i].group, prom_labels[i - 1].group)) {
+      if (i > 0)
+        frame_append("} 1\n");
+
+      frame_append("# HELP " PROM_PREFIX);
+      frame_append(prom_labels[i].group);
+      frame_append("_info");
+      for (j = 0; j < sizeof(prom_infos) / sizeof(prom_infos[0]); j++) {
+        if (STREQ(prom_infos[j].name, prom_labels[i].group)) {
+          frame_append(" ");
+          frame_append(prom_infos[j].help);
+        }
+      }
+      frame_append("\n# TYPE " PROM_PREFIX);
+      frame_append(prom_labels[i].group);
+      frame_append("_info gauge\n" PROM_PREFIX);
+      frame_append(prom_labels[i].group);
+      frame_append("_info{");
+    } else {
+      frame_append(",");
+    }
+
+    frame_append(prom_labels[i].key);
+    frame_append("=\"");
+    if ((str = field_string(prom_labels[i].field)))
+      append_escaped(str, ESCAPE_PROMETHEUS);
+    frame_append("\"");
+  }
+
+  frame_append("} 1\n");
+
+  for (i = 0; i < sizeof(prom_gauges) / sizeof(prom_gauges[0]); i++) {
+    if (!field_value(prom_gauges[i].field, num, sizeof(num)))
+      continue;
+
+    /* memory.used_bytes becomes memory_used_bytes */
+    safe_strncpy(name, field_defs[prom_gauges[i].field].key, MAX_STRLEN);
+    for (c = name; (c = strchr(c, '.'));)
+      *c = '_';
+
+    frame_append("# HELP " PROM_PREFIX);
+    frame_append(name);
+    frame_append(" ");
+    frame_append(prom_gauges[i].help);
+    frame_append("\n# TYPE " PROM_PREFIX);
+    frame_append(name);
+    frame_append(" gauge\n" PROM_PREFIX);
+    frame_append(name);
+    frame_append(" ");
+    frame_append(num);
+    frame_append("\n");
+  }
+
+  return;
+}
+
+/*	prometheus_write
+  writes the Prometheus output to dir/screenfetch_c.prom, by way of a
+  temporary file that is renamed over it once complete, so that the
+  textfile collector never reads a partial file
+  returns false (after reporting why) if the file could not be written
+*/
+bool prometheus_write(const char *dir) {
+#if !defined(__MINGW32__)
+  char tmp[MAX_STRLEN], path[MAX_STRLEN];
+  int fd;
+
+  snprintf(path, MAX_STRLEN, "%s/" PROM_FILE, dir);
+  /* the collector only reads *.prom, so it skips the temporary file */
+  snprintf(tmp, MAX_STRLEN, "%s/." PROM_FILE ".XXXXXX", dir);
+
+  if ((fd = mkstemp(tmp)) < 0) {
+    ERR_REPORT("Could not create a file in the textfile directory.");
+    return false;
+  }
+
+  main_prometheus_output();
+
+  if (frame_write(fd) || fchmod(fd, 0644) || fsync(fd)) {
+    ERR_REPORT("Could not write the Prometheus textfile.");
+    close(fd);
+    unlink(tmp);
+    return false;
+  }
+
+  if (close(fd) || rename(tmp, path)) {
+    ERR_REPORT("Could not move the Prometheus textfile into place.");
+    unlink(tmp);
+    return false;
+  }
+
+  return true;
+#else
+  (void)dir;
+  ERR_REPORT("Writing a Prometheus textfile is not supported on this platform.");
+  return false;
+#endif
+}
@@ -0,0 +1,21 @@
+/*	machine.h
+**	-------------
+**
+**	Function prototypes for machine.c, the machine-readable output modes.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_MACHINE_H
+#define SCREENFETCH_C_MACHINE_H
+
+#include <stdbool.h>
+
+void main_json_output(void);
+void main_kv_output(void);
+void main_prometheus_output(void);
+void record_json_output(const char *root, unsigned int detectors);
+void record_table_header(unsigned int detectors);
+void record_table_output(const char *root, unsigned int detectors);
+bool prometheus_write(const char *dir);
+
+#endif /* SCREENFETCH_C_MACHINE_H */
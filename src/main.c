@@ -18,10 +18,11 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <limits.h>
 #include <getopt.h>
 
 /* program includes */
-#include "arrays.h"
+#include "fields.h"
 #include "detect.h"
 #include "disp.h"
 #include "logos.h"
@@ -29,21 +30,120 @@
 #include "misc.h"
 #include "util.h"
 #include "error_flag.h"
+#include "render.h"
+#include "machine.h"
+#include "format.h"
+#include "png.h"
+#include "batch.h"
+
+/*	run_detectors
+  runs the detection functions selected in mask, along with those they
+  depend on
+*/
+static void run_detectors(unsigned int mask, bool per_core, bool per_fs,
+                          unsigned long cpu_interval) {
+  /* packages are counted the distro's way, and the themes depend on the desktop */
+  if (mask & DETECT_PKGS)
+    mask |= DETECT_DISTRO;
+  if (mask & DETECT_WM_THEME)
+    mask |= DETECT_WM | DETECT_DE;
+  if (mask & DETECT_GTK)
+    mask |= DETECT_DE;
+
+  /* the CPU usage window runs while everything else is being detected */
+  if (mask & DETECT_CPU_USAGE)
+    detect_cpu_usage_begin(per_core);
+
+  if (mask & DETECT_DISTRO)
+    detect_distro();
+  if (mask & DETECT_HOST)
+    detect_host();
+  if (mask & DETECT_KERNEL)
+    detect_kernel();
+  if (mask & DETECT_UPTIME)
+    detect_uptime();
+  if (mask & DETECT_PKGS)
+    detect_pkgs();
+  if (mask & DETECT_CPU)
+    detect_cpu();
+  if (mask & DETECT_TOPOLOGY)
+    detect_topology();
+  if (mask & DETECT_GPU)
+    detect_gpu();
+  if (mask & DETECT_DISK)
+    detect_disk(per_fs);
+  if (mask & DETECT_MEM)
+    detect_mem();
+  if (mask & DETECT_SHELL)
+    detect_shell();
+  if (mask & DETECT_RES)
+    detect_res();
+  if (mask & DETECT_DE)
+    detect_de();
+  if (mask & DETECT_WM)
+    detect_wm();
+  if (mask & DETECT_WM_THEME)
+    detect_wm_theme();
+  if (mask & DETECT_GTK)
+    detect_gtk();
+  if (mask & DETECT_CPU_USAGE)
+    detect_cpu_usage(cpu_interval);
+}
+
+/*	output_frame
+  writes the finished frame to stdout, or draws it into the PNG at png when
+  one was asked for
+  returns the program's exit status
+*/
+static int output_frame(const char *png, int level) {
+  if (!png) {
+    frame_flush();
+    return EXIT_SUCCESS;
+  }
+
+  return frame_png(png, level) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
 
 int main(int argc, char **argv) {
   bool logo = true, portrait = false;
   bool verbose = false, screenshot = false;
+  bool per_core = false, per_fs = false, cpu_usage = false;
+  unsigned long cpu_interval = 200;
+  const char *output = NULL, *textfile_dir = NULL;
+  bool prometheus = false;
+  const char *format = NULL;
+  const char *shot_file = NULL, *render_png = NULL;
+  unsigned long shot_delay = 3, png_level = PNG_DEFAULT_LEVEL;
+  bool shot_options = false, level_set = false;
+  struct format compiled;
+  const char *batch = NULL;
+  unsigned long jobs = 0;
+  unsigned long target = 0;
+  unsigned int detectors = DETECT_ALL;
+  const char *given_distro = NULL;
+  char distro[MAX_STRLEN];
+  char *end;
 
   struct option options[] = {
       {"verbose", no_argument, 0, 'v'},         {"no-logo", no_argument, 0, 'n'},
       {"screenshot", no_argument, 0, 's'},      {"distro", required_argument, 0, 'D'},
       {"suppress-errors", no_argument, 0, 'E'}, {"portrait", no_argument, 0, 'p'},
       {"version", no_argument, 0, 'V'},         {"help", no_argument, 0, 'h'},
-      {"logo-only", required_argument, 0, 'L'}, {0, 0, 0, 0}};
+      {"logo-only", required_argument, 0, 'L'}, {"cpu-interval", required_argument, 0, 'i'},
+      {"per-core", no_argument, 0, 'c'},        {"disk-breakdown", no_argument, 0, 'd'},
+      {"output", required_argument, 0, 'o'},    {"textfile-dir", required_argument, 0, 't'},
+      {"format", required_argument, 0, 'f'},    {"units", required_argument, 0, 'u'},
+      {"screenshot-file", required_argument, 0, 'S'},
+      {"screenshot-delay", required_argument, 0, 'w'},
+      {"png-level", required_argument, 0, 'z'}, {"render-png", required_argument, 0, 'r'},
+      {"batch", required_argument, 0, 'b'},     {"jobs", required_argument, 0, 'j'},
+      {"target-pid", required_argument, 0, 'P'},
+      {0, 0, 0, 0}};
 
   signed char c;
-  int index = 0;
-  while ((c = getopt_long(argc, argv, "vnsD:EpVhL:", options, &index)) != -1) {
+  int index = 0, status;
+  while ((c = getopt_long(argc, argv, "vnsD:EpVhL:i:cdo:t:f:u:S:w:z:r:b:j:P:", options, &index)) !=
+         -1) {
     switch (c) {
     case 'v':
       verbose = true;
@@ -55,7 +155,7 @@ int main(int argc, char **argv) {
       screenshot = true;
       break;
     case 'D':
-      SET_GIVEN_DISTRO(optarg);
+      given_distro = optarg;
       break;
     case 'E':
       error = false;
@@ -71,45 +171,216 @@ int main(int argc, char **argv) {
       return EXIT_SUCCESS;
     case 'L':
       output_logo_only(optarg);
+      frame_flush();
       return EXIT_SUCCESS;
+    case 'i':
+      cpu_interval = strtoul(optarg, &end, 10);
+      if (end == optarg || *end || cpu_interval > 10000) {
+        ERR_REPORT("The CPU sampling interval must be between 0 and 10000 milliseconds.");
+        return EXIT_FAILURE;
+      }
+      cpu_usage = true;
+      break;
+    case 'c':
+      per_core = true;
+      cpu_usage = true;
+      break;
+    case 'd':
+      per_fs = true;
+      break;
+    case 'o':
+      if (!STREQ(optarg, "json") && !STREQ(optarg, "kv") && !STREQ(optarg, "prometheus")) {
+        ERR_REPORT("The output format must be one of json, kv or prometheus.");
+        return EXIT_FAILURE;
+      }
+      output = optarg;
+      prometheus = STREQ(optarg, "prometheus");
+      break;
+    case 't':
+      textfile_dir = optarg;
+      break;
+    case 'f':
+      format = optarg;
+      break;
+    case 'u':
+      if (STREQ(optarg, "iec")) {
+        fields_set_units(UNITS_IEC);
+      } else if (STREQ(optarg, "si")) {
+        fields_set_units(UNITS_SI);
+      } else {
+        ERR_REPORT("The units must be either iec or si.");
+        return EXIT_FAILURE;
+      }
+      break;
+    case 'S':
+      shot_file = optarg;
+      shot_options = true;
+      break;
+    case 'w':
+      shot_delay = strtoul(optarg, &end, 10);
+      if (end == optarg || *end || shot_delay > 60) {
+        ERR_REPORT("The screenshot delay must be between 0 and 60 seconds.");
+        return EXIT_FAILURE;
+      }
+      shot_options = true;
+      break;
+    case 'z':
+      png_level = strtoul(optarg, &end, 10);
+      if (end == optarg || *end || png_level > 9) {
+        ERR_REPORT("The PNG compression level must be between 0 and 9.");
+        return EXIT_FAILURE;
+      }
+      level_set = true;
+      break;
+    case 'r':
+      render_png = optarg;
+      break;
+    case 'b':
+      batch = optarg;
+      break;
+    case 'j':
+      jobs = strtoul(optarg, &end, 10);
+      if (end == optarg || *end || jobs < 1 || jobs > BATCH_MAX_JOBS) {
+        ERR_REPORT("The number of jobs must be between 1 and 256.");
+        return EXIT_FAILURE;
+      }
+      break;
+    case 'P':
+      target = strtoul(optarg, &end, 10);
+      if (end == optarg || *end || !target || target > INT_MAX) {
+        ERR_REPORT("The target PID must be a positive process ID.");
+        return EXIT_FAILURE;
+      }
+      break;
     default:
       return EXIT_FAILURE;
     }
   }
 
-  detect_distro();
-  detect_host();
-  detect_kernel();
-  detect_uptime();
-  detect_pkgs();
-  detect_cpu();
-  detect_gpu();
-  detect_disk();
-  detect_mem();
-  detect_shell();
-  detect_res();
-  detect_de();
-  detect_wm();
-  detect_wm_theme();
-  detect_gtk();
+  if (shot_options && !screenshot) {
+    ERR_REPORT("The screenshot file and delay are only used with --screenshot.");
+    return EXIT_FAILURE;
+  }
+
+  if (level_set && !screenshot && !render_png) {
+    ERR_REPORT("The PNG level is only used with --screenshot or --render-png.");
+    return EXIT_FAILURE;
+  }
+
+  if (render_png && textfile_dir) {
+    ERR_REPORT("The Prometheus textfile cannot also be rendered to a PNG.");
+    return EXIT_FAILURE;
+  }
+
+  if (textfile_dir && !prometheus) {
+    ERR_REPORT("A textfile directory is only used with --output prometheus.");
+    return EXIT_FAILURE;
+  }
+
+  if (format && output) {
+    ERR_REPORT("A format template cannot be combined with --output.");
+    return EXIT_FAILURE;
+  }
+
+  if (jobs && !batch) {
+    ERR_REPORT("The number of jobs is only used with --batch.");
+    return EXIT_FAILURE;
+  }
+
+  if (batch && (format || screenshot || render_png || given_distro ||
+                (output && !STREQ(output, "json")))) {
+    ERR_REPORT("Batch mode writes a table, or JSON lines with --output json, and nothing else.");
+    return EXIT_FAILURE;
+  }
+
+  if (batch && target) {
+    ERR_REPORT("Batch mode cannot also inspect a target process.");
+    return EXIT_FAILURE;
+  }
+
+  /* batch mode looks at other systems' files, never at the running one */
+  if (batch) {
+#ifdef __linux
+    return batch_run(batch, jobs, output != NULL) ? EXIT_SUCCESS : EXIT_FAILURE;
+#else
+    ERR_REPORT("Batch mode is only supported on Linux.");
+    return EXIT_FAILURE;
+#endif
+  }
+
+  /* a template is parsed once, before detection, so that bad ones fail fast */
+  if (format && !format_compile(format, &compiled))
+    return EXIT_FAILURE;
+
+  /* Prometheus has better sources for CPU usage and, like the desktop, skips it */
+  if (prometheus)
+    detectors = DETECT_DISTRO | DETECT_HOST | DETECT_KERNEL | DETECT_UPTIME | DETECT_PKGS |
+                DETECT_CPU | DETECT_TOPOLOGY | DETECT_GPU | DETECT_DISK | DETECT_MEM;
+  else if (format)
+    detectors = compiled.detectors;
+  else if (!cpu_usage) /* measuring usage means waiting, so it is only done when asked for */
+    detectors &= ~DETECT_CPU_USAGE;
+
+  /* a target process is only looked at from the outside: its display and
+     mounts are out of reach */
+  if (target) {
+#ifdef __linux
+    if (!detect_target(target))
+      return EXIT_FAILURE;
+    detectors &= TARGET_DETECTORS;
+#else
+    ERR_REPORT("Inspecting a target process is only supported on Linux.");
+    return EXIT_FAILURE;
+#endif
+  }
+
+  run_detectors(detectors, per_core, per_fs, cpu_interval);
+
+  /* machine-readable output describes the real system, without logos or colors */
+  if (output) {
+    if (textfile_dir)
+      return prometheus_write(textfile_dir) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    if (STREQ(output, "json"))
+      main_json_output();
+    else if (STREQ(output, "kv"))
+      main_kv_output();
+    else
+      main_prometheus_output();
+
+    return output_frame(render_png, png_level);
+  }
 
   /* if the user specified a different OS to display, set distro_set to it */
-  if (!STREQ(given_distro_str, "Unknown"))
-    safe_strncpy(distro_str, given_distro_str, MAX_STRLEN);
+  if (given_distro) {
+    field_set_str(FIELD_OS, given_distro);
+    field_clear(FIELD_OS_BASE);
+  }
 
   if (verbose)
-    display_verbose(detected_arr, detected_arr_names);
+    display_verbose();
+
+  if (format) {
+    format_render(&compiled);
+    format_free(&compiled);
+    return output_frame(render_png, png_level);
+  }
 
   if (portrait) {
-    output_logo_only(distro_str);
-    main_text_output(detected_arr, detected_arr_names);
+    safe_strncpy(distro, field_str(field_isset(FIELD_OS_BASE) ? FIELD_OS_BASE : FIELD_OS),
+                 MAX_STRLEN);
+    output_logo_only(distro);
+    main_text_output();
   } else if (logo)
-    main_ascii_output(detected_arr, detected_arr_names);
+    main_ascii_output();
   else
-    main_text_output(detected_arr, detected_arr_names);
+    main_text_output();
+
+  if ((status = output_frame(render_png, png_level)) != EXIT_SUCCESS)
+    return status;
 
-  if (screenshot)
-    take_screenshot(verbose);
+  if (screenshot && !take_screenshot(shot_file, shot_delay, png_level, verbose))
+    return EXIT_FAILURE;
 
   return EXIT_SUCCESS;
 }
@@ -12,7 +12,6 @@
 #define MB (KB * KB)
 #define GB (MB * KB)
 #define MAX_STRLEN 512
-#define SET_GIVEN_DISTRO(str) (safe_strncpy(given_distro_str, str, MAX_STRLEN))
 #define STREQ(x, y) (!strcmp(x, y))
 #define STRCASEEQ(x, y) (!strcasecmp(x, y))
 #define BEGINS_WITH(x, y) (!strncmp(x, y, strlen(y)))
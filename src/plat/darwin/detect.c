@@ -33,7 +33,7 @@
 #include <mach/mach_host.h>
 
 /* program includes */
-#include "../../arrays.h"
+#include "../../fields.h"
 #include "../../colors.h"
 #include "../../misc.h"
 #include "../../disp.h"
@@ -89,14 +89,13 @@ void detect_distro(void) {
     }
   }
 
-  snprintf(distro_str, MAX_STRLEN, "%s %d.%d.%d (%s)", codename, maj, min, fix, build_ver);
-  safe_strncpy(host_color, TLBL, MAX_STRLEN);
+  field_printf(FIELD_OS, "%s %d.%d.%d (%s)", codename, maj, min, fix, build_ver);
 
   return;
 }
 
 /*	detect_host
-  detects the computer's hostname and active user and formats them
+  detects the computer's hostname and active user
 */
 void detect_host(void) {
   char *given_user = "Unknown";
@@ -107,8 +106,8 @@ void detect_host(void) {
   uname(&host_info);
   safe_strncpy(given_host, host_info.nodename, MAX_STRLEN);
 
-  snprintf(host_str, MAX_STRLEN, "%s%s%s%s@%s%s%s%s", host_color, given_user, TNRM, TWHT, TNRM,
-           host_color, given_host, TNRM);
+  field_set_str(FIELD_USER, given_user);
+  field_set_str(FIELD_HOSTNAME, given_host);
 
   return;
 }
@@ -120,8 +119,8 @@ void detect_kernel(void) {
   struct utsname kern_info;
 
   uname(&kern_info);
-  snprintf(kernel_str, MAX_STRLEN, "%s %s %s", kern_info.sysname, kern_info.release,
-           kern_info.machine);
+  field_printf(FIELD_KERNEL, "%s %s %s", kern_info.sysname, kern_info.release,
+               kern_info.machine);
 
   return;
 }
@@ -131,10 +130,6 @@ void detect_kernel(void) {
 */
 void detect_uptime(void) {
   long long uptime = 0;
-  unsigned int secs = 0;
-  unsigned int mins = 0;
-  unsigned int hrs = 0;
-  unsigned int days = 0;
 
   /* three cheers for undocumented functions and structs */
   static mach_timebase_info_data_t timebase_info;
@@ -147,12 +142,7 @@ void detect_uptime(void) {
                        (1000 * 1000 * timebase_info.denom));
   uptime /= 1000;
 
-  split_uptime(uptime, &secs, &mins, &hrs, &days);
-
-  if (days > 0)
-    snprintf(uptime_str, MAX_STRLEN, "%dd %dh %dm %ds", days, hrs, mins, secs);
-  else
-    snprintf(uptime_str, MAX_STRLEN, "%dh %dm %ds", hrs, mins, secs);
+  field_set_int(FIELD_UPTIME, uptime);
 
   return;
 }
@@ -172,7 +162,7 @@ void detect_pkgs(void) {
 
   globfree(&gl);
 
-  snprintf(pkgs_str, MAX_STRLEN, "%d", packages);
+  field_set_int(FIELD_PKGS, packages);
 
   return;
 }
@@ -181,8 +171,90 @@ void detect_pkgs(void) {
   detects the computer's CPU brand/name-string
 */
 void detect_cpu(void) {
+  char cpu[MAX_STRLEN];
   size_t size = MAX_STRLEN;
-  sysctlbyname("machdep.cpu.brand_string", cpu_str, &size, NULL, 0);
+
+  if (!sysctlbyname("machdep.cpu.brand_string", cpu, &size, NULL, 0))
+    field_set_str(FIELD_CPU_MODEL, cpu);
+  return;
+}
+
+/*	detect_topology
+  detects the computer's CPU topology (packages, cores, threads, performance
+  levels and caches)
+*/
+void detect_topology(void) {
+  int packages = 1, cores = 0, threads = 0, perflevels = 0, pcores = 0, ecores = 0;
+  int64_t l1d = 0, l1i = 0, l2 = 0, l3 = 0;
+  char caches[MAX_STRLEN] = "";
+  size_t size;
+  int len = 0;
+
+  size = sizeof(int);
+  sysctlbyname("hw.packages", &packages, &size, NULL, 0);
+  size = sizeof(int);
+  sysctlbyname("hw.physicalcpu", &cores, &size, NULL, 0);
+  size = sizeof(int);
+  sysctlbyname("hw.logicalcpu", &threads, &size, NULL, 0);
+
+  if (cores > 0 && threads > 0) {
+    field_set_int(FIELD_CPU_PACKAGES, packages);
+    field_set_int(FIELD_CPU_CORE_COUNT, cores);
+    field_set_int(FIELD_CPU_THREAD_COUNT, threads);
+    field_set_int(FIELD_CPU_SMT, threads / cores);
+  }
+
+  /* Apple Silicon splits its cores into performance levels */
+  size = sizeof(int);
+  if (!sysctlbyname("hw.nperflevels", &perflevels, &size, NULL, 0) && perflevels > 1) {
+    size = sizeof(int);
+    sysctlbyname("hw.perflevel0.physicalcpu", &pcores, &size, NULL, 0);
+    size = sizeof(int);
+    sysctlbyname("hw.perflevel1.physicalcpu", &ecores, &size, NULL, 0);
+    field_set_int(FIELD_CPU_PCORES, pcores);
+    field_set_int(FIELD_CPU_ECORES, ecores);
+  }
+
+  size = sizeof(int64_t);
+  sysctlbyname("hw.l1dcachesize", &l1d, &size, NULL, 0);
+  size = sizeof(int64_t);
+  sysctlbyname("hw.l1icachesize", &l1i, &size, NULL, 0);
+  size = sizeof(int64_t);
+  sysctlbyname("hw.l2cachesize", &l2, &size, NULL, 0);
+  size = sizeof(int64_t);
+  sysctlbyname("hw.l3cachesize", &l3, &size, NULL, 0);
+
+  if (l1d > 0 && l1i > 0)
+    len += snprintf(caches + len, MAX_STRLEN - len, "L1 %lldK+%lldK", (long long)l1d / KB,
+                    (long long)l1i / KB);
+  if (l2 > 0)
+    len += snprintf(caches + len, MAX_STRLEN - len, "%sL2 %lldK", len ? ", " : "",
+                    (long long)l2 / KB);
+  if (l3 > 0)
+    snprintf(caches + len, MAX_STRLEN - len, "%sL3 %lldK", len ? ", " : "", (long long)l3 / KB);
+
+  if (caches[0])
+    field_set_str(FIELD_CPU_CACHES, caches);
+
+  return;
+}
+
+/*	detect_cpu_usage_begin
+  takes the first CPU time sample for detect_cpu_usage
+*/
+void detect_cpu_usage_begin(bool per_core) {
+  (void)per_core;
+  return;
+}
+
+/*	detect_cpu_usage
+  detects the CPU utilisation over a short sampling window
+  --
+  CAVEAT: this is not implemented on OS X yet, so the usage is left as 'Unknown'
+  --
+*/
+void detect_cpu_usage(unsigned int interval_ms) {
+  (void)interval_ms;
   return;
 }
 
@@ -204,7 +276,7 @@ void detect_gpu(void) {
       }
       const void *GPUModel = CFDictionaryGetValue(serviceDictionary, CFSTR("model"));
       if (GPUModel && CFGetTypeID(GPUModel) == CFDataGetTypeID())
-        safe_strncpy(gpu_str, (char *)CFDataGetBytePtr((CFDataRef)GPUModel), MAX_STRLEN);
+        field_set_str(FIELD_GPU, (char *)CFDataGetBytePtr((CFDataRef)GPUModel));
       CFRelease(serviceDictionary);
       IOObjectRelease(regEntry);
     }
@@ -216,16 +288,17 @@ void detect_gpu(void) {
 
 /*	detect_disk
   detects the computer's total disk capacity and usage
+  argument bool per_fs: unused, the per-filesystem breakdown is Linux-only
 */
-void detect_disk(void) {
+void detect_disk(bool per_fs) {
   struct statfs disk_info;
-  long disk_total = 0, disk_used = 0, disk_percentage = 0;
+
+  (void)per_fs;
 
   if (!(statfs(getenv("HOME"), &disk_info))) {
-    disk_total = ((disk_info.f_blocks * disk_info.f_bsize) / GB);
-    disk_used = (((disk_info.f_blocks - disk_info.f_bfree) * disk_info.f_bsize) / GB);
-    disk_percentage = (((float)disk_used / disk_total) * 100);
-    snprintf(disk_str, MAX_STRLEN, "%ldG / %ldG (%ld%%)", disk_used, disk_total, disk_percentage);
+    field_set_int(FIELD_DISK_TOTAL, (long long)disk_info.f_blocks * disk_info.f_bsize);
+    field_set_int(FIELD_DISK_USED,
+                  (long long)(disk_info.f_blocks - disk_info.f_bfree) * disk_info.f_bsize);
   } else if (error) {
     ERR_REPORT("Could not stat $HOME for filesystem statistics.");
   }
@@ -252,8 +325,8 @@ void detect_mem(void) {
 
   size_t len = sizeof(total_mem);
   sysctlbyname("hw.memsize", &total_mem, &len, NULL, 0);
-
-  snprintf(mem_str, MAX_STRLEN, "%lld%s / %lld%s", used_mem / MB, "MB", total_mem / MB, "MB");
+  field_set_int(FIELD_MEM_TOTAL, total_mem);
+  field_set_int(FIELD_MEM_USED, used_mem);
 
   return;
 }
@@ -281,30 +354,30 @@ void detect_shell(void) {
   }
 
   if (STREQ(shell_name, "/bin/sh")) {
-    safe_strncpy(shell_str, "POSIX sh", MAX_STRLEN);
+    field_set_str(FIELD_SHELL, "POSIX sh");
   } else if (strstr(shell_name, "bash")) {
     shell_file = popen("bash --version | head -1", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "bash %.*s", 17, vers_str + 10);
+    field_printf(FIELD_SHELL, "bash %.*s", 17, vers_str + 10);
     pclose(shell_file);
   } else if (strstr(shell_name, "zsh")) {
     shell_file = popen("zsh --version", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "zsh %.*s", 5, vers_str + 4);
+    field_printf(FIELD_SHELL, "zsh %.*s", 5, vers_str + 4);
     pclose(shell_file);
   } else if (strstr(shell_name, "csh")) {
     shell_file = popen("csh --version | head -1", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "csh %.*s", 7, vers_str + 5);
+    field_printf(FIELD_SHELL, "csh %.*s", 7, vers_str + 5);
     pclose(shell_file);
   } else if (strstr(shell_name, "fish")) {
     shell_file = popen("fish --version", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "fish %.*s", 13, vers_str + 6);
+    field_printf(FIELD_SHELL, "fish %.*s", 13, vers_str + 6);
     pclose(shell_file);
   } else if (strstr(shell_name, "dash") || strstr(shell_name, "ash") || strstr(shell_name, "ksh")) {
     /* i don't have a version detection system for these, yet */
-    safe_strncpy(shell_str, shell_name, MAX_STRLEN);
+    field_set_str(FIELD_SHELL, shell_name);
   }
 
   return;
@@ -315,15 +388,17 @@ void detect_shell(void) {
 */
 void detect_res(void) {
   uint32_t count = 0, chars = 0;
+  char res[MAX_STRLEN];
   CGGetOnlineDisplayList(UINT32_MAX, NULL, &count);
   CGDirectDisplayID displays[count];
   CGGetOnlineDisplayList(count, displays, &count);
-  chars += snprintf(res_str, MAX_STRLEN, "%zu x %zu", CGDisplayPixelsWide(*displays),
+  chars += snprintf(res, MAX_STRLEN, "%zu x %zu", CGDisplayPixelsWide(*displays),
                     CGDisplayPixelsHigh(*displays));
-  for (int i = 1; i < count; ++i) {
-    chars += snprintf(res_str + chars, MAX_STRLEN, ", %zu x %zu", CGDisplayPixelsWide(displays[i]),
-                      CGDisplayPixelsHigh(displays[i]));
+  for (int i = 1; i < count && chars < MAX_STRLEN; ++i) {
+    chars += snprintf(res + chars, MAX_STRLEN - chars, ", %zu x %zu",
+                      CGDisplayPixelsWide(displays[i]), CGDisplayPixelsHigh(displays[i]));
   }
+  field_set_str(FIELD_RES, res);
   return;
 }
 
@@ -332,7 +407,7 @@ void detect_res(void) {
   On OS X, this will always be Aqua.
 */
 void detect_de(void) {
-  safe_strncpy(de_str, "Aqua", MAX_STRLEN);
+  field_set_str(FIELD_DE, "Aqua");
 
   return;
 }
@@ -342,7 +417,7 @@ void detect_de(void) {
   On OS X, this will always be the Quartz Compositor.
 */
 void detect_wm(void) {
-  safe_strncpy(wm_str, "Quartz Compositor", MAX_STRLEN);
+  field_set_str(FIELD_WM, "Quartz Compositor");
 
   return;
 }
@@ -368,15 +443,13 @@ void detect_wm_theme(void) {
   } else {
     color = "Blue";
   }
-  snprintf(wm_theme_str, MAX_STRLEN, "%s %s", style ? "Dark" : "Light", color);
+  field_printf(FIELD_WM_THEME, "%s %s", style ? "Dark" : "Light", color);
   return;
 }
 
 /*	detect_gtk
-  OS X doesn't use GTK, so this function fills str with "Not Applicable"
+  OS X doesn't use GTK, so the GTK fields are left undetected
 */
 void detect_gtk(void) {
-  safe_strncpy(gtk_str, "Not Applicable", MAX_STRLEN);
-
   return;
 }
@@ -0,0 +1,224 @@
+/*	batch.c
+**	-------------
+**
+**	Batch mode: the file-based detectors in sysroot.c are run against every
+**	root directory in a list by a pool of worker threads, each root with a
+**	field set of its own, while the main thread writes the finished records
+**	out in the order of the list as soon as each one is ready.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* linux-specific includes */
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+/* program includes */
+#include "../../batch.h"
+#include "../../fields.h"
+#include "../../machine.h"
+#include "../../misc.h"
+#include "../../disp.h"
+#include "../../render.h"
+#include "../../error_flag.h"
+#include "sysroot.h"
+
+struct batch_job {
+  char *root; /* as listed, less any trailing slash */
+  struct fields fields;
+  bool done;
+};
+
+/* the jobs, shared between the main thread and the workers */
+struct batch {
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  struct batch_job *jobs;
+  size_t n_jobs;
+  size_t next; /* the next job to hand out */
+};
+
+/*	batch_read
+  reads the list of roots, one per line, from the file at path (or stdin
+  if path is "-"), skipping blank lines and # comments
+  returns false (after reporting why) if it could not be read
+*/
+static bool batch_read(struct batch *b, const char *path) {
+  struct batch_job *grown;
+  size_t cap = 0, n = 0, len;
+  char *line = NULL;
+  FILE *list;
+  bool ok = true;
+
+  if (!(list = STREQ(path, "-") ? stdin : fopen(path, "r"))) {
+    ERR_REPORT("Could not open the list of roots.");
+    return false;
+  }
+
+  while (ok && getline(&line, &cap, list) >= 0) {
+    len = strcspn(line, "\n");
+    while (len > 1 && line[len - 1] == '/')
+      len--;
+    line[len] = '\0';
+
+    if (!len || line[0] == '#')
+      continue;
+
+    if (!(n & (n - 1))) {
+      if ((grown = realloc(b->jobs, (n ? 2 * n : 16) * sizeof(*grown))))
+        b->jobs = grown;
+      else
+        ok = false;
+    }
+
+    if (ok && (b->jobs[n].root = strdup(line))) {
+      memset(&b->jobs[n].fields, 0, sizeof(b->jobs[n].fields));
+      b->jobs[n++].done = false;
+    } else {
+      ok = false;
+    }
+  }
+
+  if (!ok)
+    ERR_REPORT("Out of memory while reading the list of roots.");
+  else if (ferror(list))
+    ERR_REPORT("Could not read the list of roots.");
+
+  ok = ok && !ferror(list);
+  b->n_jobs = n;
+  free(line);
+  if (list != stdin)
+    fclose(list);
+
+  return ok;
+}
+
+/*	batch_detect
+  runs the file-based detectors against a job's root, into its field set
+*/
+static void batch_detect(struct batch_job *job) {
+  const char *root = STREQ(job->root, "/") ? "" : job->root;
+  char msg[MAX_STRLEN];
+  struct stat st;
+
+  if (stat(job->root, &st) || !S_ISDIR(st.st_mode)) {
+    if (error) {
+      snprintf(msg, sizeof(msg), "%s is not a directory.", job->root);
+      ERR_REPORT(msg);
+    }
+    return;
+  }
+
+  fields_use(&job->fields);
+
+  sysroot_distro(root);
+  sysroot_kernel(root);
+  sysroot_pkgs(root);
+  sysroot_shell(root);
+
+  fields_use(NULL);
+}
+
+/*	batch_worker
+  takes jobs until there are none left
+*/
+static void *batch_worker(void *arg) {
+  struct batch *b = arg;
+  struct batch_job *job;
+
+  for (;;) {
+    pthread_mutex_lock(&b->lock);
+    job = b->next < b->n_jobs ? &b->jobs[b->next++] : NULL;
+    pthread_mutex_unlock(&b->lock);
+
+    if (!job)
+      return NULL;
+
+    batch_detect(job);
+
+    pthread_mutex_lock(&b->lock);
+    job->done = true;
+    pthread_cond_broadcast(&b->cond);
+    pthread_mutex_unlock(&b->lock);
+  }
+}
+
+/*	batch_run
+  detects every root in the list at path with jobs workers (one per CPU
+  if 0) and writes a record per root, as a table row or a JSON line
+  returns false if the list could not be read
+*/
+bool batch_run(const char *path, unsigned int jobs, bool json) {
+  struct batch b;
+  pthread_t *threads;
+  unsigned int n_threads = 0;
+  long cpus;
+  size_t i;
+
+  memset(&b, 0, sizeof(b));
+
+  if (!batch_read(&b, path)) {
+    for (i = 0; i < b.n_jobs; i++)
+      free(b.jobs[i].root);
+    free(b.jobs);
+    return false;
+  }
+
+  if (!jobs)
+    jobs = (cpus = sysconf(_SC_NPROCESSORS_ONLN)) > 0 ? (unsigned int)cpus : 1;
+  if (jobs > BATCH_MAX_JOBS)
+    jobs = BATCH_MAX_JOBS;
+  if (jobs > b.n_jobs)
+    jobs = b.n_jobs;
+
+  pthread_mutex_init(&b.lock, NULL);
+  pthread_cond_init(&b.cond, NULL);
+
+  if ((threads = malloc(jobs * sizeof(*threads)))) {
+    for (; n_threads < jobs; n_threads++) {
+      if (pthread_create(&threads[n_threads], NULL, batch_worker, &b))
+        break;
+    }
+  }
+
+  /* no thread to spare: do it all inline */
+  if (!n_threads)
+    batch_worker(&b);
+
+  if (!json)
+    record_table_header(BATCH_DETECTORS);
+
+  for (i = 0; i < b.n_jobs; i++) {
+    pthread_mutex_lock(&b.lock);
+    while (!b.jobs[i].done)
+      pthread_cond_wait(&b.cond, &b.lock);
+    pthread_mutex_unlock(&b.lock);
+
+    fields_use(&b.jobs[i].fields);
+    if (json)
+      record_json_output(b.jobs[i].root, BATCH_DETECTORS);
+    else
+      record_table_output(b.jobs[i].root, BATCH_DETECTORS);
+    fields_use(NULL);
+
+    frame_flush();
+    fields_free(&b.jobs[i].fields);
+    free(b.jobs[i].root);
+  }
+
+  while (n_threads)
+    pthread_join(threads[--n_threads], NULL);
+
+  pthread_cond_destroy(&b.cond);
+  pthread_mutex_destroy(&b.lock);
+  free(threads);
+  free(b.jobs);
+
+  return true;
+}
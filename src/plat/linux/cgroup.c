@@ -0,0 +1,254 @@
+/*	cgroup.c
+**	-------------
+**
+**	Reads the limits a process's cgroups put on it, so that a containerized
+**	process can be told what it may actually use rather than what the host
+**	has. Works on the unified (v2) hierarchy and on the v1 controllers, with
+**	a handful of small single-read files: the process's cgroup is found in
+**	/proc/PID/cgroup, and each limit is the tightest along the way from it
+**	up to the root of the hierarchy.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* linux-specific includes */
+#include <unistd.h>
+
+/* program includes */
+#include "../../misc.h"
+#include "../../util.h"
+#include "cgroup.h"
+
+#define CGROUP_BUFSIZE (4 * KB)
+
+/* v1 reports an unlimited memory cgroup as a huge page-aligned number */
+#define V1_UNLIMITED (1LL << 62)
+
+/* a cgroup's directory, and where its hierarchy's root ends in it */
+struct cgroup_dir {
+  char path[MAX_STRLEN];
+  size_t root_len;
+  bool v2;
+};
+
+/*	has_controller
+  returns true if name is in the comma-separated list of controllers
+*/
+static bool has_controller(const char *list, const char *name) {
+  size_t len = strlen(name);
+
+  for (;;) {
+    if (!strncmp(list, name, len) && (list[len] == ',' || !list[len]))
+      return true;
+    if (!(list = strchr(list, ',')))
+      return false;
+    list++;
+  }
+}
+
+/*	cgroup_find
+  finds the directory of the cgroup the process is in for a v1 controller,
+  or in the unified hierarchy if the system has one, from the text of its
+  /proc/PID/cgroup file (lines of id:controllers:path) and the cgroup mount
+  returns false if the process is in no such cgroup
+*/
+static bool cgroup_find(const char *text, const char *mount, const char *controller, bool v2,
+                        struct cgroup_dir *dir) {
+  char buf[CGROUP_BUFSIZE];
+  char *line, *next, *ctrls = NULL, *path = NULL;
+
+  safe_strncpy(buf, text, sizeof(buf));
+
+  for (line = buf; line && *line; line = next) {
+    if ((next = strchr(line, '\n')))
+      *next++ = '\0';
+
+    if (!(ctrls = strchr(line, ':')) || !(path = strchr(++ctrls, ':')))
+      continue;
+    *path++ = '\0';
+
+    /* a v1 hierarchy is mounted under the names of all its controllers */
+    if (v2 ? !*ctrls : has_controller(ctrls, controller))
+      break;
+  }
+
+  if (!line || !*line)
+    return false;
+
+  dir->v2 = v2;
+  dir->root_len = snprintf(dir->path, MAX_STRLEN, "%s%s%s", mount, v2 ? "" : "/",
+                           v2 ? "" : ctrls);
+  if (dir->root_len >= MAX_STRLEN)
+    return false;
+
+  /* the process may be in a cgroup namespace of its own (or we may be), in
+     which case its path is not below our mount: the mount is then its root */
+  if (!STREQ(path, "/") &&
+      snprintf(dir->path + dir->root_len, MAX_STRLEN - dir->root_len, "%s", path) >=
+          (int)(MAX_STRLEN - dir->root_len))
+    return false;
+  if (!FILE_EXISTS(dir->path))
+    dir->path[dir->root_len] = '\0';
+
+  return FILE_EXISTS(dir->path);
+}
+
+/*	read_number
+  reads the first number in the file at dir/name
+  returns it, -1 if the file says "max", or -2 if it could not be read
+*/
+static double read_number(const char *dir, const char *name) {
+  char path[MAX_STRLEN], buf[64], *end;
+  double v;
+
+  if (snprintf(path, MAX_STRLEN, "%s/%s", dir, name) >= MAX_STRLEN ||
+      read_file(path, buf, sizeof(buf)) <= 0)
+    return -2;
+
+  if (BEGINS_WITH(buf, "max"))
+    return -1;
+
+  v = strtod(buf, &end);
+  return end == buf ? -2 : v;
+}
+
+/*	mem_limit
+  returns the memory limit of one cgroup, or -1 if it has none
+*/
+static double mem_limit(const char *dir, bool v2) {
+  double v = read_number(dir, v2 ? "memory.max" : "memory.limit_in_bytes");
+
+  return v < 0 || v >= V1_UNLIMITED ? -1 : v;
+}
+
+/*	cpu_limit
+  returns the CPU bandwidth quota of one cgroup in CPUs, or -1 if it has none
+*/
+static double cpu_limit(const char *dir, bool v2) {
+  char path[MAX_STRLEN], buf[64], *end;
+  double quota, period;
+
+  if (!v2) {
+    quota = read_number(dir, "cpu.cfs_quota_us");
+    period = read_number(dir, "cpu.cfs_period_us");
+    return quota > 0 && period > 0 ? quota / period : -1;
+  }
+
+  /* "quota period", where the quota may be "max" */
+  if (snprintf(path, MAX_STRLEN, "%s/cpu.max", dir) >= MAX_STRLEN ||
+      read_file(path, buf, sizeof(buf)) <= 0 || BEGINS_WITH(buf, "max"))
+    return -1;
+
+  quota = strtod(buf, &end);
+  period = strtod(end, NULL);
+  return quota > 0 && period > 0 ? quota / period : -1;
+}
+
+/*	pids_limit
+  returns the task limit of one cgroup, or -1 if it has none
+*/
+static double pids_limit(const char *dir, bool v2) {
+  double v = read_number(dir, "pids.max");
+
+  (void)v2;
+  return v < 0 ? -1 : v;
+}
+
+/*	tightest
+  applies limit to the cgroup and each of its ancestors up to the root of
+  its hierarchy
+  returns the smallest limit found, or -1 if there is none
+*/
+static double tightest(const struct cgroup_dir *dir, double (*limit)(const char *, bool)) {
+  char path[MAX_STRLEN], *slash;
+  double v, min = -1;
+
+  safe_strncpy(path, dir->path, MAX_STRLEN);
+
+  for (;;) {
+    if ((v = limit(path, dir->v2)) >= 0 && (min < 0 || v < min))
+      min = v;
+
+    if (strlen(path) <= dir->root_len || !(slash = strrchr(path, '/')))
+      break;
+    *slash = '\0';
+  }
+
+  return min;
+}
+
+/*	cpulist_count
+  returns the number of CPUs in a kernel cpulist ("0-3,8,10-11")
+*/
+static unsigned int cpulist_count(const char *list) {
+  unsigned long first, last;
+  unsigned int n = 0;
+  char *end;
+
+  while (*list >= '0' && *list <= '9') {
+    first = last = strtoul(list, &end, 10);
+    if (*end == '-')
+      last = strtoul(end + 1, &end, 10);
+    if (last >= first)
+      n += last - first + 1;
+    list = *end == ',' ? end + 1 : end;
+  }
+
+  return n;
+}
+
+/*	cgroup_read
+  fills cg with the limits that the given controllers put on the process
+  whose cgroup file (/proc/self/cgroup, or /proc/PID/cgroup) is at
+  proc_cgroup, with the cgroup hierarchies mounted at mount (normally
+  CGROUP_MOUNT)
+  returns false if the process's cgroups could not be read
+*/
+bool cgroup_read(const char *mount, const char *proc_cgroup, unsigned int controllers,
+                 struct cgroup_limits *cg) {
+  char text[CGROUP_BUFSIZE], path[MAX_STRLEN];
+  struct cgroup_dir dir;
+  bool v2;
+
+  cg->mem_max = cg->mem_current = cg->pids_max = -1;
+  cg->cpus = -1;
+  cg->cpuset[0] = '\0';
+  cg->cpuset_cpus = 0;
+
+  if (read_file(proc_cgroup, text, sizeof(text)) <= 0)
+    return false;
+
+  /* hybrid systems mount the unified hierarchy elsewhere, with no controllers */
+  if (snprintf(path, MAX_STRLEN, "%s/cgroup.controllers", mount) >= MAX_STRLEN)
+    return false;
+  v2 = FILE_EXISTS(path);
+
+  if (controllers & CGROUP_MEMORY && cgroup_find(text, mount, "memory", v2, &dir)) {
+    cg->mem_max = tightest(&dir, mem_limit);
+    cg->mem_current = read_number(dir.path, v2 ? "memory.current" : "memory.usage_in_bytes");
+    if (cg->mem_current < 0)
+      cg->mem_current = -1;
+  }
+
+  if (controllers & CGROUP_CPU && cgroup_find(text, mount, "cpu", v2, &dir))
+    cg->cpus = tightest(&dir, cpu_limit);
+
+  if (controllers & CGROUP_PIDS && cgroup_find(text, mount, "pids", v2, &dir))
+    cg->pids_max = tightest(&dir, pids_limit);
+
+  if (controllers & CGROUP_CPUSET && cgroup_find(text, mount, "cpuset", v2, &dir)) {
+    if (snprintf(path, MAX_STRLEN, "%s/%s", dir.path,
+                 v2 ? "cpuset.cpus.effective" : "cpuset.effective_cpus") < MAX_STRLEN &&
+        read_file(path, cg->cpuset, sizeof(cg->cpuset)) > 0) {
+      cg->cpuset[strcspn(cg->cpuset, "\n")] = '\0';
+      cg->cpuset_cpus = cpulist_count(cg->cpuset);
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,40 @@
+/*	cgroup.h
+**	-------------
+**
+**	The resource limits a process's cgroups put on it, and the prototypes of
+**	their reader.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_CGROUP_H
+#define SCREENFETCH_C_CGROUP_H
+
+#include <stdbool.h>
+
+#include "../../misc.h"
+
+#define CGROUP_MOUNT "/sys/fs/cgroup"
+
+/* the controllers to read the limits of */
+enum cgroup_controller {
+  CGROUP_MEMORY = 1 << 0,
+  CGROUP_CPU = 1 << 1,
+  CGROUP_CPUSET = 1 << 2,
+  CGROUP_PIDS = 1 << 3,
+};
+
+/* the limits in effect, the tightest of the cgroup's and its ancestors'; -1
+   stands for no limit (or, for mem_current, an unknown figure) */
+struct cgroup_limits {
+  long long mem_max;     /* bytes */
+  long long mem_current; /* bytes */
+  double cpus;           /* the CPU bandwidth quota, in CPUs */
+  long long pids_max;
+  char cpuset[MAX_STRLEN]; /* the CPUs it may run on, as a cpulist, or "" */
+  unsigned int cpuset_cpus; /* how many those are, or 0 */
+};
+
+bool cgroup_read(const char *mount, const char *proc_cgroup, unsigned int controllers,
+                 struct cgroup_limits *cg);
+
+#endif /* SCREENFETCH_C_CGROUP_H */
@@ -0,0 +1,307 @@
+/*	cpuinfo.c
+**	-------------
+**
+**	A parser for /proc/cpuinfo that works across architectures: the file is
+**	read in one go and scanned line by line with memchr(), picking out the
+**	model string, the package/core/thread counts and the clock speeds.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* linux-specific includes */
+#include <unistd.h>
+
+/* program includes */
+#include "../../misc.h"
+#include "../../util.h"
+#include "cpuinfo.h"
+
+/* how strongly each key identifies the CPU model; the highest wins */
+struct model_key {
+  const char *key;
+  int rank;
+};
+
+static const struct model_key model_keys[] = {
+    {"model name", 6}, /* x86, LoongArch */
+    {"cpu model", 5},  /* MIPS */
+    {"cpu", 5},        /* POWER */
+    {"uarch", 5},      /* RISC-V */
+    {"Processor", 4},  /* 32-bit ARM */
+    {"Model", 3},      /* Raspberry Pi board name */
+    {"Hardware", 2},   /* ARM SoC; ARM64 otherwise only has its cores' part numbers */
+    {"isa", 1},        /* RISC-V without uarch */
+    {"vendor_id", 1},  /* s390x: "IBM/S390" */
+};
+
+/* ARM64 kernels name no model at all, only the implementer and part numbers
+   of each core: these are the common ones */
+struct arm_id {
+  unsigned int id;
+  const char *name;
+};
+
+static const struct arm_id arm_implementers[] = {
+    {0x41, "ARM"},    {0x42, "Broadcom"}, {0x43, "Cavium"}, {0x48, "HiSilicon"},
+    {0x4e, "NVIDIA"}, {0x50, "APM"},      {0x51, "Qualcomm"}, {0x61, "Apple"},
+    {0xc0, "Ampere"},
+};
+
+/* implementer << 12 | part */
+static const struct arm_id arm_parts[] = {
+    {0x41d03, "Cortex-A53"},     {0x41d04, "Cortex-A35"},     {0x41d05, "Cortex-A55"},
+    {0x41d07, "Cortex-A57"},     {0x41d08, "Cortex-A72"},     {0x41d09, "Cortex-A73"},
+    {0x41d0a, "Cortex-A75"},     {0x41d0b, "Cortex-A76"},     {0x41d0c, "Neoverse-N1"},
+    {0x41d0d, "Cortex-A77"},     {0x41d40, "Neoverse-V1"},    {0x41d41, "Cortex-A78"},
+    {0x41d44, "Cortex-X1"},      {0x41d46, "Cortex-A510"},    {0x41d47, "Cortex-A710"},
+    {0x41d48, "Cortex-X2"},      {0x41d49, "Neoverse-N2"},    {0x41d4d, "Cortex-A715"},
+    {0x41d4e, "Cortex-X3"},      {0x41d4f, "Neoverse-V2"},    {0x41d80, "Cortex-A520"},
+    {0x41d81, "Cortex-A720"},    {0x41d82, "Cortex-X4"},      {0x430af, "ThunderX2"},
+    {0x48d01, "TaiShan v110"},   {0x4e004, "Carmel"},         {0x51800, "Kryo 2XX Gold"},
+    {0x51801, "Kryo 2XX Silver"}, {0x51802, "Kryo 3XX Gold"}, {0x51803, "Kryo 3XX Silver"},
+    {0x51804, "Kryo 4XX Gold"},  {0x51805, "Kryo 4XX Silver"}, {0x51c00, "Falkor"},
+    {0x61022, "M1 Icestorm"},    {0x61023, "M1 Firestorm"},   {0xc0ac3, "Ampere-1"},
+};
+
+#define MAX_ARM_CORES 4
+
+/*	arm_name
+  looks id up in table
+  returns its name, or NULL if it is not there
+*/
+static const char *arm_name(const struct arm_id *table, size_t n, unsigned int id) {
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    if (table[i].id == id)
+      return table[i].name;
+  }
+
+  return NULL;
+}
+
+/*	arm_model
+  names the n distinct kinds of core (implementer << 12 | part) into
+  ci->model, as in "ARM Cortex-A55 + Cortex-A76"
+*/
+static void arm_model(struct cpuinfo *ci, const unsigned int *cores, size_t n) {
+  char vendor[32], part[32];
+  const char *name;
+  size_t i, len = 0;
+  bool same;
+
+  for (i = 0; i < n; i++) {
+    if ((name = arm_name(arm_implementers,
+                         sizeof(arm_implementers) / sizeof(arm_implementers[0]), cores[i] >> 12)))
+      safe_strncpy(vendor, name, sizeof(vendor));
+    else
+      snprintf(vendor, sizeof(vendor), "0x%02x", cores[i] >> 12);
+
+    if ((name = arm_name(arm_parts, sizeof(arm_parts) / sizeof(arm_parts[0]), cores[i])))
+      safe_strncpy(part, name, sizeof(part));
+    else
+      snprintf(part, sizeof(part), "0x%03x", cores[i] & 0xfff);
+
+    /* the vendor is named once for each run of its cores */
+    same = i > 0 && cores[i] >> 12 == cores[i - 1] >> 12;
+    len += snprintf(ci->model + len, MAX_STRLEN - len, "%s%s%s%s", i ? " + " : "",
+                    same ? "" : vendor, same ? "" : " ", part);
+  }
+}
+
+/*	cmp_u64
+  qsort comparator for the (package, core) pairs
+*/
+static int cmp_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+/*	copy_model
+  copies a model string into ci->model, collapsing runs of whitespace
+  and dropping POWER's ", altivec supported" style suffixes
+*/
+static void copy_model(struct cpuinfo *ci, const char *val, size_t len, bool cut_comma) {
+  size_t i, o = 0;
+
+  for (i = 0; i < len && o < MAX_STRLEN - 1; i++) {
+    if (cut_comma && val[i] == ',')
+      break;
+    if ((val[i] == ' ' || val[i] == '\t') && (o == 0 || ci->model[o - 1] == ' '))
+      continue;
+
+    ci->model[o++] = val[i] == '\t' ? ' ' : val[i];
+  }
+
+  while (o > 0 && ci->model[o - 1] == ' ')
+    o--;
+  ci->model[o] = '\0';
+}
+
+/*	read_sysfs_mhz
+  reads the first CPU's cpufreq value name (in kHz) from the sysfs CPU
+  directory sysfs_cpu and returns it in MHz, or 0
+*/
+static double read_sysfs_mhz(const char *sysfs_cpu, const char *name) {
+  char path[MAX_STRLEN], buf[32];
+
+  if (snprintf(path, MAX_STRLEN, "%s/cpu0/cpufreq/%s", sysfs_cpu, name) >= MAX_STRLEN ||
+      read_file(path, buf, sizeof(buf)) <= 0)
+    return 0;
+
+  return strtod(buf, NULL) / 1000.0;
+}
+
+/*	cpuinfo_read
+  fills ci from the cpuinfo file at path (normally /proc/cpuinfo) and from
+  cpufreq in the sysfs CPU directory sysfs_cpu (normally
+  /sys/devices/system/cpu), for the frequency limits
+  returns false if the cpuinfo file could not be read
+*/
+bool cpuinfo_read(const char *path, const char *sysfs_cpu, struct cpuinfo *ci) {
+  char *buf, *line, *eol, *colon, *key_end, *val;
+  size_t len, i, n_pairs = 0, cap_pairs = 0;
+  uint64_t *pairs = NULL, phys = 0;
+  unsigned int processors = 0, declared = 0;
+  double mhz, mhz_sum = 0;
+  unsigned int mhz_count = 0;
+  unsigned int arm_cores[MAX_ARM_CORES], implementer = 0, core;
+  size_t n_arm = 0;
+  int model_rank = 0;
+
+  memset(ci, 0, sizeof(*ci));
+
+  if (!(buf = read_file_alloc(path, &len)))
+    return false;
+
+  for (line = buf; line < buf + len; line = eol + 1) {
+    if (!(eol = memchr(line, '\n', buf + len - line)))
+      eol = buf + len;
+
+    if (!(colon = memchr(line, ':', eol - line)))
+      continue;
+
+    for (key_end = colon; key_end > line && (key_end[-1] == ' ' || key_end[-1] == '\t');)
+      key_end--;
+
+    for (val = colon + 1; val < eol && (*val == ' ' || *val == '\t');)
+      val++;
+
+    *key_end = '\0';
+    *eol = '\0';
+    mhz = -1;
+
+    /* dispatch on the first byte so most lines cost a single comparison */
+    switch (line[0]) {
+    case 'p':
+      if (BEGINS_WITH(line, "processor")) {
+        processors++;
+      } else if (STREQ(line, "physical id")) {
+        phys = strtoull(val, NULL, 10);
+      }
+      break;
+    case 'c':
+      if (STREQ(line, "core id")) {
+        if (n_pairs == cap_pairs) {
+          uint64_t *grown;
+
+          cap_pairs = cap_pairs ? cap_pairs * 2 : 64;
+          if (!(grown = realloc(pairs, cap_pairs * sizeof(*pairs))))
+            break;
+          pairs = grown;
+        }
+        pairs[n_pairs++] = phys << 32 | (strtoull(val, NULL, 10) & 0xffffffffu);
+      } else if (STREQ(line, "cpu MHz") || STREQ(line, "clock")) {
+        /* POWER reports "clock : 3800.000000MHz" */
+        mhz = strtod(val, NULL);
+      }
+      break;
+    case 'C':
+      /* ARM64: "CPU implementer : 0x41", then "CPU part : 0xd08" */
+      if (STREQ(line, "CPU implementer")) {
+        implementer = strtoul(val, NULL, 0) & 0xff;
+      } else if (STREQ(line, "CPU part")) {
+        core = implementer << 12 | (strtoul(val, NULL, 0) & 0xfff);
+        for (i = 0; i < n_arm && arm_cores[i] != core; i++)
+          ;
+        if (i == n_arm && n_arm < MAX_ARM_CORES)
+          arm_cores[n_arm++] = core;
+      }
+      break;
+    case '#':
+      /* s390x: "# processors : 4" */
+      if (STREQ(line, "# processors"))
+        declared = strtoul(val, NULL, 10);
+      break;
+    }
+
+    if (mhz > 0) {
+      if (mhz_count == 0 || mhz < ci->mhz_min)
+        ci->mhz_min = mhz;
+      if (mhz > ci->mhz_max)
+        ci->mhz_max = mhz;
+      mhz_sum += mhz;
+      mhz_count++;
+      continue;
+    }
+
+    for (i = 0; i < sizeof(model_keys) / sizeof(model_keys[0]); i++) {
+      if (model_keys[i].rank > model_rank && *val && STREQ(line, model_keys[i].key)) {
+        copy_model(ci, val, eol - val, STREQ(line, "cpu"));
+        model_rank = model_keys[i].rank;
+        break;
+      }
+    }
+  }
+
+  free(buf);
+
+  /* the cores' names beat nothing, or a bare ISA, but not the SoC's */
+  if (model_rank < 2 && n_arm > 0)
+    arm_model(ci, arm_cores, n_arm);
+
+  ci->threads = processors > declared ? processors : declared;
+
+  if (n_pairs > 0) {
+    qsort(pairs, n_pairs, sizeof(*pairs), cmp_u64);
+
+    for (i = 0; i < n_pairs; i++) {
+      if (i == 0 || pairs[i] != pairs[i - 1]) {
+        ci->cores++;
+        if (i == 0 || pairs[i] >> 32 != pairs[i - 1] >> 32)
+          ci->packages++;
+      }
+    }
+  } else {
+    /* no topology in cpuinfo (ARM, POWER, s390x): assume one thread per core */
+    ci->cores = ci->threads;
+    ci->packages = ci->threads ? 1 : 0;
+  }
+
+  free(pairs);
+
+  if (mhz_count > 0)
+    ci->mhz_cur = mhz_sum / mhz_count;
+  else
+    ci->mhz_cur = read_sysfs_mhz(sysfs_cpu, "scaling_cur_freq");
+
+  /* the hardware limits are better bounds than whatever was sampled above */
+  if ((mhz = read_sysfs_mhz(sysfs_cpu, "cpuinfo_min_freq")) > 0)
+    ci->mhz_min = mhz;
+  if ((mhz = read_sysfs_mhz(sysfs_cpu, "cpuinfo_max_freq")) > 0)
+    ci->mhz_max = mhz;
+
+  if (ci->mhz_min == 0)
+    ci->mhz_min = ci->mhz_cur;
+  if (ci->mhz_max == 0)
+    ci->mhz_max = ci->mhz_cur;
+
+  return true;
+}
@@ -0,0 +1,27 @@
+/*	cpuinfo.h
+**	-------------
+**
+**	The /proc/cpuinfo summary and its parser's prototype.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_CPUINFO_H
+#define SCREENFETCH_C_CPUINFO_H
+
+#include <stdbool.h>
+
+#include "../../misc.h"
+
+struct cpuinfo {
+  char model[MAX_STRLEN];
+  unsigned int packages;
+  unsigned int cores;
+  unsigned int threads;
+  double mhz_min;
+  double mhz_max;
+  double mhz_cur;
+};
+
+bool cpuinfo_read(const char *path, const char *sysfs_cpu, struct cpuinfo *ci);
+
+#endif /* SCREENFETCH_C_CPUINFO_H */
@@ -0,0 +1,353 @@
+/*	dconf.c
+**	-------------
+**
+**	A read-only reader for the GVariant databases (GVDB) used by dconf and
+**	GSettings, so that settings can be looked up without spawning gsettings.
+**	The user database (~/.config/dconf/user) is consulted first, and the
+**	defaults from the compiled GSettings schemas are used as a fallback.
+**	Each database is mapped at most once per process.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+/* linux-specific includes */
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* program includes */
+#include "../../misc.h"
+#include "../../util.h"
+#include "dconf.h"
+
+#define GVDB_HEADER_SIZE 24
+#define GVDB_ITEM_SIZE 24
+#define GVDB_NO_PARENT 0xffffffffu
+#define MAX_SCHEMA_FILES 8
+
+struct gvdb_file {
+  const unsigned char *data;
+  size_t size;
+  bool tried;
+};
+
+struct gvdb_table {
+  const struct gvdb_file *file;
+  const unsigned char *buckets;
+  const unsigned char *items;
+  uint32_t n_buckets;
+  uint32_t n_items;
+};
+
+static struct gvdb_file user_db;
+static struct gvdb_file schema_dbs[MAX_SCHEMA_FILES];
+static int n_schema_dbs = -1;
+
+/*	le32, le16
+  read little-endian integers from a (possibly unaligned) GVDB buffer
+*/
+static uint32_t le32(const unsigned char *p) {
+  return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint16_t le16(const unsigned char *p) {
+  return (uint16_t)(p[0] | p[1] << 8);
+}
+
+/*	gvdb_map
+  maps the GVDB file at path into f, leaving f empty if it is missing or
+  not a (little-endian) GVDB file
+*/
+static void gvdb_map(struct gvdb_file *f, const char *path) {
+  struct stat st;
+  void *data;
+  int fd;
+
+  f->tried = true;
+
+  if ((fd = open(path, O_RDONLY | O_CLOEXEC)) < 0)
+    return;
+
+  if (!fstat(fd, &st) && st.st_size >= GVDB_HEADER_SIZE) {
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (data != MAP_FAILED) {
+      if (!memcmp(data, "GVariant", 8)) {
+        f->data = data;
+        f->size = st.st_size;
+      } else {
+        munmap(data, st.st_size);
+      }
+    }
+  }
+
+  close(fd);
+}
+
+/*	gvdb_table_init
+  sets up the hash table whose bounds are stored in the pointer at ptr
+  returns false if the table is out of bounds or malformed
+*/
+static bool gvdb_table_init(struct gvdb_table *t, const struct gvdb_file *f,
+                            const unsigned char *ptr) {
+  uint32_t start = le32(ptr), end = le32(ptr + 4);
+  uint32_t n_bloom;
+  size_t pos;
+
+  if (start > end || end > f->size || (start & 3) || end - start < 8)
+    return false;
+
+  n_bloom = le32(f->data + start) & ((1u << 27) - 1);
+  t->n_buckets = le32(f->data + start + 4);
+
+  pos = start + 8 + (size_t)n_bloom * 4;
+  if (pos > end || (end - pos) / 4 < t->n_buckets)
+    return false;
+
+  t->file = f;
+  t->buckets = f->data + pos;
+  pos += (size_t)t->n_buckets * 4;
+  t->items = f->data + pos;
+  t->n_items = (end - pos) / GVDB_ITEM_SIZE;
+
+  return true;
+}
+
+/*	gvdb_hash
+  the djb2 variant GVDB uses to hash keys
+*/
+static uint32_t gvdb_hash(const char *key) {
+  uint32_t h = 5381;
+
+  while (*key)
+    h = h * 33 + (signed char)*key++;
+
+  return h;
+}
+
+/*	gvdb_check_name
+  GVDB only stores each key's suffix relative to its parent item, so the
+  full name is matched back to front while walking up the parent chain
+*/
+static bool gvdb_check_name(const struct gvdb_table *t, const unsigned char *item,
+                            const char *key, size_t key_len) {
+  uint32_t start, parent;
+  uint16_t size;
+
+  for (;;) {
+    start = le32(item + 8);
+    size = le16(item + 12);
+
+    if ((size_t)start + size > t->file->size || size > key_len)
+      return false;
+
+    key_len -= size;
+    if (memcmp(t->file->data + start, key + key_len, size))
+      return false;
+
+    parent = le32(item + 4);
+    if (key_len == 0 && parent == GVDB_NO_PARENT)
+      return true;
+
+    /* empty-named parents are allowed, but a chain must make progress */
+    if (parent >= t->n_items || size == 0)
+      return false;
+
+    item = t->items + (size_t)parent * GVDB_ITEM_SIZE;
+  }
+}
+
+/*	gvdb_lookup
+  returns the hash item for key with the given type tag, or NULL
+*/
+static const unsigned char *gvdb_lookup(const struct gvdb_table *t, const char *key, char type) {
+  uint32_t hash, bucket, itemno, lastno;
+  size_t key_len = strlen(key);
+  const unsigned char *item;
+
+  if (t->n_buckets == 0 || t->n_items == 0)
+    return NULL;
+
+  hash = gvdb_hash(key);
+  bucket = hash % t->n_buckets;
+  itemno = le32(t->buckets + (size_t)bucket * 4);
+
+  if (bucket == t->n_buckets - 1 || (lastno = le32(t->buckets + ((size_t)bucket + 1) * 4)) >
+                                         t->n_items)
+    lastno = t->n_items;
+
+  for (; itemno < lastno; itemno++) {
+    item = t->items + (size_t)itemno * GVDB_ITEM_SIZE;
+
+    if (le32(item) == hash && item[14] == type && gvdb_check_name(t, item, key, key_len))
+      return item;
+  }
+
+  return NULL;
+}
+
+/*	variant_string
+  extracts a string from the serialized 'v' GVariant referenced by item
+  the payload is either a plain 's' (dconf databases) or a tuple whose first
+  member is an 's' (compiled schema keys); both start with the NUL-terminated
+  string itself, and the variant's type string follows the last NUL byte
+*/
+static bool variant_string(const struct gvdb_file *f, const unsigned char *item, char *out) {
+  uint32_t start = le32(item + 16), end = le32(item + 20);
+  const unsigned char *data, *sep;
+  const char *type;
+  size_t len;
+
+  if (start >= end || end > f->size)
+    return false;
+
+  data = f->data + start;
+  len = end - start;
+
+  for (sep = data + len - 1; sep > data && *sep; sep--)
+    ;
+
+  type = (const char *)sep + 1;
+  if (sep == data || (size_t)(type - (const char *)data) >= len)
+    return false;
+
+  if (!((*type == 's' && type + 1 == (const char *)data + len) ||
+        (type[0] == '(' && type[1] == 's')))
+    return false;
+
+  if (!*data)
+    return false;
+
+  safe_strncpy(out, (const char *)data, MAX_STRLEN);
+  return true;
+}
+
+/*	user_db_lookup
+  looks up the absolute dconf path in the user database
+*/
+static bool user_db_lookup(const char *path, char *out) {
+  struct gvdb_table root;
+  const unsigned char *item;
+  char db_path[MAX_STRLEN];
+  const char *xdg, *home;
+
+  if (!user_db.tried) {
+    if ((xdg = getenv("XDG_CONFIG_HOME")) && *xdg)
+      snprintf(db_path, MAX_STRLEN, "%s/dconf/user", xdg);
+    else if ((home = getenv("HOME")))
+      snprintf(db_path, MAX_STRLEN, "%s/.config/dconf/user", home);
+    else
+      db_path[0] = '\0';
+
+    gvdb_map(&user_db, db_path);
+  }
+
+  if (!user_db.data || !gvdb_table_init(&root, &user_db, user_db.data + 16))
+    return false;
+
+  return (item = gvdb_lookup(&root, path, 'v')) && variant_string(&user_db, item, out);
+}
+
+/*	schema_dbs_open
+  maps every gschemas.compiled found in $GSETTINGS_SCHEMA_DIR and
+  $XDG_DATA_DIRS (in that order of precedence)
+*/
+static void schema_dbs_open(void) {
+  char dirs[MAX_STRLEN];
+  char path[MAX_STRLEN];
+  char *env, *dir, *save = NULL;
+
+  n_schema_dbs = 0;
+
+  if ((env = getenv("GSETTINGS_SCHEMA_DIR"))) {
+    snprintf(path, MAX_STRLEN, "%s/gschemas.compiled", env);
+    gvdb_map(&schema_dbs[n_schema_dbs], path);
+    if (schema_dbs[n_schema_dbs].data)
+      n_schema_dbs++;
+  }
+
+  env = getenv("XDG_DATA_DIRS");
+  safe_strncpy(dirs, env && *env ? env : "/usr/local/share:/usr/share", MAX_STRLEN);
+
+  for (dir = strtok_r(dirs, ":", &save); dir && n_schema_dbs < MAX_SCHEMA_FILES;
+       dir = strtok_r(NULL, ":", &save)) {
+    snprintf(path, MAX_STRLEN, "%s/glib-2.0/schemas/gschemas.compiled", dir);
+    gvdb_map(&schema_dbs[n_schema_dbs], path);
+    if (schema_dbs[n_schema_dbs].data)
+      n_schema_dbs++;
+  }
+}
+
+/*	schema_lookup
+  finds the schema's table in the compiled schema files, copying its dconf
+  path into path and, if key is in the schema, its default value into out
+  returns true if the schema exists at all
+*/
+static bool schema_lookup(const char *schema, const char *key, char *path, bool *found,
+                          char *out) {
+  struct gvdb_table root, table;
+  const unsigned char *item;
+  int i;
+
+  if (n_schema_dbs < 0)
+    schema_dbs_open();
+
+  for (i = 0; i < n_schema_dbs; i++) {
+    if (!gvdb_table_init(&root, &schema_dbs[i], schema_dbs[i].data + 16))
+      continue;
+
+    if (!(item = gvdb_lookup(&root, schema, 'H')) ||
+        !gvdb_table_init(&table, &schema_dbs[i], item + 16))
+      continue;
+
+    if ((item = gvdb_lookup(&table, ".path", 'v')))
+      variant_string(&schema_dbs[i], item, path);
+
+    *found = (item = gvdb_lookup(&table, key, 'v')) && variant_string(&schema_dbs[i], item, out);
+    return true;
+  }
+
+  return false;
+}
+
+/*	dconf_read_string
+  looks up the string value of key in the GSettings schema schema, first in
+  the user's dconf database and then in the schema defaults
+  returns true and fills out (MAX_STRLEN bytes) if a non-empty value was found
+*/
+bool dconf_read_string(const char *schema, const char *key, char *out) {
+  char path[MAX_STRLEN] = "";
+  char full[MAX_STRLEN];
+  char def[MAX_STRLEN];
+  bool have_default = false;
+  size_t i;
+
+  if (!schema_lookup(schema, key, path, &have_default, def) || !*path) {
+    /* relocatable or uninstalled schema: fall back to the conventional path */
+    path[0] = '/';
+    for (i = 0; schema[i] && i < MAX_STRLEN - 3; i++)
+      path[i + 1] = schema[i] == '.' ? '/' : tolower((unsigned char)schema[i]);
+    path[i + 1] = '/';
+    path[i + 2] = '\0';
+  }
+
+  snprintf(full, MAX_STRLEN, "%s%s", path, key);
+
+  if (user_db_lookup(full, out))
+    return true;
+
+  if (have_default) {
+    safe_strncpy(out, def, MAX_STRLEN);
+    return true;
+  }
+
+  return false;
+}
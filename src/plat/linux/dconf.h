@@ -0,0 +1,15 @@
+/*	dconf.h
+**	-------------
+**
+**	Function prototypes for dconf.c.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_DCONF_H
+#define SCREENFETCH_C_DCONF_H
+
+#include <stdbool.h>
+
+bool dconf_read_string(const char *schema, const char *key, char *out);
+
+#endif /* SCREENFETCH_C_DCONF_H */
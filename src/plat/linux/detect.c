@@ -12,7 +12,9 @@
 #include <stdbool.h>
 #include <string.h>
 #include <strings.h>
+#include <errno.h>
 #include <getopt.h>
+#include <time.h>
 
 /* linux-specific includes */
 #include <unistd.h>
@@ -21,20 +23,31 @@
 #include <sys/statvfs.h>
 #include <sys/types.h>
 #include <pwd.h>
+#include <dirent.h>
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
 #include <GL/gl.h>
 #include <GL/glx.h>
-#include <glob.h>
 #include <mntent.h>
 
 /* program includes */
-#include "../../arrays.h"
+#include "../../fields.h"
 #include "../../colors.h"
 #include "../../misc.h"
 #include "../../disp.h"
 #include "../../util.h"
 #include "../../error_flag.h"
+#include "cgroup.h"
+#include "dconf.h"
+#include "cpuinfo.h"
+#include "gtk.h"
+#include "kde.h"
+#include "meminfo.h"
+#include "mounts.h"
+#include "procstat.h"
+#include "sysroot.h"
+#include "topology.h"
+#include "x11.h"
 
 /*	remove preceding and trailing single quote character,
   remove trailing newline
@@ -55,131 +68,79 @@ static void unquote(char *s) {
   }
 }
 
+/* the process inspected with --target-pid: its root directory ("" for our
+   own) and its cgroup file */
+static char target_root[MAX_STRLEN] = "";
+static char target_cgroup[MAX_STRLEN] = "/proc/self/cgroup";
+
+/*	detect_target
+  points the detectors at the process pid, whose files are read through
+  /proc/pid/root and whose limits through its cgroups, without entering any
+  of its namespaces
+  returns false if the process cannot be looked into
+*/
+bool detect_target(unsigned long pid) {
+  char root[MAX_STRLEN];
+  DIR *dir;
+
+  snprintf(root, MAX_STRLEN, "/proc/%lu/root", pid);
+  if (!(dir = opendir(root))) {
+    ERR_REPORT(errno == ENOENT ? "There is no process with the target PID."
+                               : "Could not read the target process's root directory.");
+    return false;
+  }
+  closedir(dir);
+
+  safe_strncpy(target_root, root, MAX_STRLEN);
+  snprintf(target_cgroup, MAX_STRLEN, "/proc/%lu/cgroup", pid);
+
+  return true;
+}
+
 /*	detect_distro
-  detects the computer's distribution (really only relevant on Linux)
+  detects the computer's distribution
 */
 void detect_distro(void) {
-  /* if distro_str was NOT set by the -D flag */
-  if (STREQ(distro_str, "Unknown")) {
-    FILE *distro_file;
-
-    char distro_name_str[MAX_STRLEN];
-
-    if (FILE_EXISTS("/system/bin/getprop")) {
-      safe_strncpy(distro_str, "Android", MAX_STRLEN);
-      safe_strncpy(host_color, TLGN, MAX_STRLEN);
-    } else {
-      bool detected = false;
-
-      /* Bad solution, as /etc/issue contains junk on some distros */
-      distro_file = fopen("/etc/issue", "r");
-
-      if (distro_file != NULL) {
-        /* get the first 4 chars, that's all we need */
-        fscanf(distro_file, "%4s", distro_name_str);
-        fclose(distro_file);
-
-        if (STREQ(distro_name_str, "Kali")) {
-          safe_strncpy(distro_str, "Kali Linux", MAX_STRLEN);
-          detected = true;
-          safe_strncpy(host_color, TLBL, MAX_STRLEN);
-        } else if (STREQ(distro_name_str, "Back")) {
-          safe_strncpy(distro_str, "Backtrack Linux", MAX_STRLEN);
-          detected = true;
-          safe_strncpy(host_color, TLRD, MAX_STRLEN);
-        } else if (STREQ(distro_name_str, "Crun")) {
-          safe_strncpy(distro_str, "CrunchBang", MAX_STRLEN);
-          detected = true;
-          safe_strncpy(host_color, TDGY, MAX_STRLEN);
-        } else if (STREQ(distro_name_str, "LMDE")) {
-          safe_strncpy(distro_str, "LMDE", MAX_STRLEN);
-          detected = true;
-          safe_strncpy(host_color, TLGN, MAX_STRLEN);
-        } else if (STREQ(distro_name_str, "Debi") || STREQ(distro_name_str, "Rasp")) {
-          safe_strncpy(distro_str, "Debian", MAX_STRLEN);
-          detected = true;
-          safe_strncpy(host_color, TLRD, MAX_STRLEN);
-        }
-      }
+  /* if the distro was NOT set by the -D flag */
+  if (field_isset(FIELD_OS))
+    return;
 
-      if (!detected) {
-        if (FILE_EXISTS("/etc/redhat-release")) {
-          safe_strncpy(distro_str, "Red Hat Linux", MAX_STRLEN);
-          safe_strncpy(host_color, TLRD, MAX_STRLEN);
-        } else if (FILE_EXISTS("/etc/fedora-release")) {
-          safe_strncpy(distro_str, "Fedora", MAX_STRLEN);
-          safe_strncpy(host_color, TLBL, MAX_STRLEN);
-        } else if (FILE_EXISTS("/etc/SuSE-release")) {
-          safe_strncpy(distro_str, "OpenSUSE", MAX_STRLEN);
-          safe_strncpy(host_color, TLGN, MAX_STRLEN);
-        } else if (FILE_EXISTS("/etc/arch-release")) {
-          safe_strncpy(distro_str, "Arch Linux", MAX_STRLEN);
-          safe_strncpy(host_color, TLCY, MAX_STRLEN);
-        } else if (FILE_EXISTS("/etc/gentoo-release")) {
-          safe_strncpy(distro_str, "Gentoo", MAX_STRLEN);
-          safe_strncpy(host_color, TLPR, MAX_STRLEN);
-        } else if (FILE_EXISTS("/etc/angstrom-version")) {
-          safe_strncpy(distro_str, "Angstrom", MAX_STRLEN);
-          safe_strncpy(host_color, TNRM, MAX_STRLEN);
-        } else if (FILE_EXISTS("/etc/manjaro-release")) {
-          safe_strncpy(distro_str, "Manjaro", MAX_STRLEN);
-          safe_strncpy(host_color, TLGN, MAX_STRLEN);
-        } else if (FILE_EXISTS("/etc/slackware-release")) {
-          safe_strncpy(distro_str, "Slackware", MAX_STRLEN);
-          safe_strncpy(host_color, TLBL, MAX_STRLEN);
-        } else if (FILE_EXISTS("/etc/lsb-release")) {
-          distro_file = fopen("/etc/lsb-release", "r");
-          fscanf(distro_file, "%s ", distro_name_str);
-          fclose(distro_file);
-
-          snprintf(distro_str, MAX_STRLEN, "%s", distro_name_str + 11);
-          safe_strncpy(host_color, TLRD, MAX_STRLEN);
-        } else if (FILE_EXISTS("/etc/os-release")) {
-          /*
-            TODO: Parse NAME or PRETTY_NAME from os-release
-            Until then, spit out an error message.
-          */
-          if (error)
-            ERR_REPORT("Failed to detect a Linux distro (1).");
-        } else {
-          safe_strncpy(distro_str, "Linux", MAX_STRLEN);
-          safe_strncpy(host_color, TLGY, MAX_STRLEN);
-
-          if (error) {
-            ERR_REPORT("Failed to detect a Linux distro (2).");
-          }
-        }
-      }
-    }
-  }
+  sysroot_distro(target_root);
 
   return;
 }
 
 /*	detect_host
-  detects the computer's hostname and active user and formats them
+  detects the computer's hostname and active user; a target process's user
+  is left undetected, as ours says nothing about it
 */
 void detect_host(void) {
-  char given_user[MAX_STRLEN] = "Unknown";
-  char given_host[MAX_STRLEN] = "Unknown";
+  char path[MAX_STRLEN];
+  char given_host[MAX_STRLEN];
   struct passwd *user_info;
   struct utsname host_info;
 
-  if ((user_info = getpwuid(geteuid()))) {
-    safe_strncpy(given_user, user_info->pw_name, MAX_STRLEN);
-  } else if (error) {
-    ERR_REPORT("Could not detect username.");
+  /* our user is not the target's, so it has none */
+  if (!target_root[0]) {
+    if ((user_info = getpwuid(geteuid())))
+      field_set_str(FIELD_USER, user_info->pw_name);
+    else if (error)
+      ERR_REPORT("Could not detect username.");
   }
 
-  if (!(uname(&host_info))) {
-    safe_strncpy(given_host, host_info.nodename, MAX_STRLEN);
+  /* a container's hostname lives in its UTS namespace, which we stay out of:
+     the one it was given is usually in its /etc/hostname */
+  if (target_root[0] &&
+      read_file(sysroot_path(path, target_root, "/etc/hostname"), given_host, MAX_STRLEN) > 0 &&
+      given_host[strspn(given_host, " \t\n")]) {
+    given_host[strcspn(given_host, "\n")] = '\0';
+    field_set_str(FIELD_HOSTNAME, given_host);
+  } else if (!(uname(&host_info))) {
+    field_set_str(FIELD_HOSTNAME, host_info.nodename);
   } else if (error) {
     ERR_REPORT("Could not detect hostname.");
   }
 
-  snprintf(host_str, MAX_STRLEN, "%s%s%s%s@%s%s%s%s", host_color, given_user, TNRM, TWHT, TNRM,
-           host_color, given_host, TNRM);
-
   return;
 }
 
@@ -190,11 +151,11 @@ void detect_kernel(void) {
   struct utsname kern_info;
 
   if (!(uname(&kern_info))) {
-    snprintf(kernel_str, MAX_STRLEN, "%s %s %s", kern_info.sysname, kern_info.release,
-             kern_info.machine);
+    field_printf(FIELD_KERNEL, "%s %s %s", kern_info.sysname, kern_info.release,
+                 kern_info.machine);
   } else if (error) {
     ERR_REPORT("Could not detect kernel information.");
-    safe_strncpy(kernel_str, "Linux", MAX_STRLEN);
+    field_set_str(FIELD_KERNEL, "Linux");
   }
 
   return;
@@ -204,19 +165,10 @@ void detect_kernel(void) {
   detects the computer's uptime
 */
 void detect_uptime(void) {
-  unsigned int secs = 0;
-  unsigned int mins = 0;
-  unsigned int hrs = 0;
-  unsigned int days = 0;
   struct sysinfo si_upt;
 
   if (!(sysinfo(&si_upt))) {
-    split_uptime(si_upt.uptime, &secs, &mins, &hrs, &days);
-
-    if (days > 0)
-      snprintf(uptime_str, MAX_STRLEN, "%dd %dh %dm %ds", days, hrs, mins, secs);
-    else
-      snprintf(uptime_str, MAX_STRLEN, "%dh %dm %ds", hrs, mins, secs);
+    field_set_int(FIELD_UPTIME, si_upt.uptime);
   } else {
     ERR_REPORT("Could not detect system uptime.");
   }
@@ -228,119 +180,236 @@ void detect_uptime(void) {
   detects the number of packages installed on the computer
 */
 void detect_pkgs(void) {
-  FILE *pkgs_file;
-  int packages = 0;
-  glob_t gl;
-
-  if (STREQ(distro_str, "Arch Linux") || STREQ(distro_str, "ParabolaGNU/Linux-libre") ||
-      STREQ(distro_str, "Chakra") || STREQ(distro_str, "Manjaro")) {
-    if (!(glob("/var/lib/pacman/local/*", GLOB_NOSORT, NULL, &gl))) {
-      packages = gl.gl_pathc;
-    } else if (error) {
-      ERR_REPORT("Failure while globbing packages.");
-    }
+  sysroot_pkgs(target_root);
 
-    globfree(&gl);
-  } else if (STREQ(distro_str, "Frugalware")) {
-    pkgs_file = popen("pacman-g2 -Q 2> /dev/null | wc -l", "r");
-    fscanf(pkgs_file, "%d", &packages);
-    pclose(pkgs_file);
-  } else if (STREQ(distro_str, "Ubuntu") || STREQ(distro_str, "Lubuntu") ||
-             STREQ(distro_str, "Xubuntu") || STREQ(distro_str, "LinuxMint") ||
-             STREQ(distro_str, "SolusOS") || STREQ(distro_str, "Debian") ||
-             STREQ(distro_str, "LMDE") || STREQ(distro_str, "CrunchBang") ||
-             STREQ(distro_str, "Peppermint") || STREQ(distro_str, "LinuxDeepin") ||
-             STREQ(distro_str, "Trisquel") || STREQ(distro_str, "elementary OS") ||
-             STREQ(distro_str, "Backtrack Linux") || STREQ(distro_str, "Kali Linux")) {
-    if (!(glob("/var/lib/dpkg/info/*.list", GLOB_NOSORT, NULL, &gl))) {
-      packages = gl.gl_pathc;
-    } else if (error) {
-      ERR_REPORT("Failure while globbing packages.");
-    }
+  return;
+}
 
-    globfree(&gl);
-  } else if (STREQ(distro_str, "Slackware")) {
-    if (!(glob("/var/log/packages/*", GLOB_NOSORT, NULL, &gl))) {
-      packages = gl.gl_pathc;
-    } else if (error) {
-      ERR_REPORT("Failure while globbing packages.");
-    }
+/*	cpu_limits
+  detects the CPU bandwidth, CPUs and tasks that the cgroups of the process
+  whose cgroup file is at proc_cgroup allow it, noting them next to the CPU
+*/
+static void cpu_limits(const char *proc_cgroup) {
+  struct cgroup_limits cg;
+  char note[MAX_STRLEN];
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
 
-    globfree(&gl);
-  } else if (STREQ(distro_str, "Gentoo") || STREQ(distro_str, "Sabayon") ||
-             STREQ(distro_str, "Funtoo")) {
-    if (!(glob("/var/db/pkg/*/*", GLOB_NOSORT, NULL, &gl))) {
-      packages = gl.gl_pathc;
-    } else if (error) {
-      ERR_REPORT("Failure while globbing packages.");
-    }
+  if (!cgroup_read(CGROUP_MOUNT, proc_cgroup, CGROUP_CPU | CGROUP_CPUSET | CGROUP_PIDS, &cg))
+    return;
+
+  if (cg.cpus >= 0) {
+    field_set_real(FIELD_CPU_LIMIT, cg.cpus);
+    snprintf(note, MAX_STRLEN, "cgroup %g CPUs", cg.cpus);
+    field_list_add(FIELD_CPU_CGROUP, note);
+  }
+
+  if (cg.cpuset[0]) {
+    field_set_str(FIELD_CPU_CPUSET, cg.cpuset);
+
+    /* only worth showing when it leaves some CPUs out */
+    if (cg.cpuset_cpus > 0 && (long)cg.cpuset_cpus < cpus &&
+        snprintf(note, MAX_STRLEN, "cpuset %s", cg.cpuset) < MAX_STRLEN)
+      field_list_add(FIELD_CPU_CGROUP, note);
+  }
+
+  if (cg.pids_max >= 0) {
+    field_set_int(FIELD_PIDS_LIMIT, cg.pids_max);
+    snprintf(note, MAX_STRLEN, "pids.max %lld", cg.pids_max);
+    field_list_add(FIELD_CPU_CGROUP, note);
+  }
+}
+
+/*	detect_cpu
+  detects the computer's CPU brand/name-string, core/thread counts and clock,
+  and the share of them the process's cgroups allow it
+*/
+void detect_cpu(void) {
+  struct cpuinfo ci;
+  char *at;
+
+  cpu_limits(target_cgroup);
 
-    globfree(&gl);
-  } else if (STREQ(distro_str, "Fuduntu") || STREQ(distro_str, "Fedora") ||
-             STREQ(distro_str, "OpenSUSE") || STREQ(distro_str, "Red Hat Linux") ||
-             STREQ(distro_str, "Mandriva") || STREQ(distro_str, "Mandrake") ||
-             STREQ(distro_str, "Mageia") || STREQ(distro_str, "Viperr")) {
-    /* RPM uses Berkeley DBs internally, so this won't change soon */
-    pkgs_file = popen("rpm -qa 2> /dev/null | wc -l", "r");
-    fscanf(pkgs_file, "%d", &packages);
-    pclose(pkgs_file);
-  } else if (STREQ(distro_str, "Angstrom")) {
-    pkgs_file = popen("opkg list-installed 2> /dev/null | wc -l", "r");
-    fscanf(pkgs_file, "%d", &packages);
-    pclose(pkgs_file);
-  } else if (STREQ(distro_str, "Linux")) /* if linux disto detection failed */
-  {
-    safe_strncpy(pkgs_str, "Not Found", MAX_STRLEN);
+  if (!cpuinfo_read("/proc/cpuinfo", "/sys/devices/system/cpu", &ci)) {
+    if (error)
+      ERR_REPORT("Failed to open /proc/cpuinfo. Ancient Linux kernel?");
+    return;
+  }
 
+  if (!ci.model[0]) {
     if (error)
-      ERR_REPORT("Packages cannot be detected on an unknown "
-                 "Linux distro.");
+      ERR_REPORT("Could not find a model name in /proc/cpuinfo.");
+    return;
+  }
+
+  if (STREQ(ci.model, "ARMv6-compatible processor rev 7 (v6l)"))
+    safe_strncpy(ci.model, "BCM2708 (Raspberry Pi)", MAX_STRLEN);
+
+  /* Intel's brand strings carry their base clock; the real limit is shown instead */
+  if (ci.mhz_max > 0) {
+    if ((at = strstr(ci.model, " @ ")))
+      *at = '\0';
+    field_set_real(FIELD_CPU_MHZ, ci.mhz_max);
   }
 
-  snprintf(pkgs_str, MAX_STRLEN, "%d", packages);
+  field_set_str(FIELD_CPU_MODEL, ci.model);
+
+  if (ci.threads > 0) {
+    field_set_int(FIELD_CPU_PACKAGES, ci.packages);
+    field_set_int(FIELD_CPU_CORE_COUNT, ci.cores);
+    field_set_int(FIELD_CPU_THREAD_COUNT, ci.threads);
+  }
 
   return;
 }
 
-/*	detect_cpu
-  detects the computer's CPU brand/name-string
+/*	format_cache_size
+  formats a cache size given in KiB as "48K" or "1.25M"
 */
-void detect_cpu(void) {
-  FILE *cpu_file;
-  char cpuinfo_buf[MAX_STRLEN];
-  char *cpuinfo_line;
-  int end;
-
-  if ((cpu_file = fopen("/proc/cpuinfo", "r"))) {
-    /* read past the first 4 lines (#5 is model name) */
-    for (int i = 0; i < 5; i++) {
-      if (!(fgets(cpuinfo_buf, MAX_STRLEN, cpu_file))) {
-        ERR_REPORT("Fatal error while reading /proc/cpuinfo");
-        return;
-      }
-    }
+static void format_cache_size(char *buf, size_t len, unsigned long size_kb) {
+  if (size_kb >= KB)
+    snprintf(buf, len, "%gM", size_kb / (double)KB);
+  else
+    snprintf(buf, len, "%luK", size_kb);
+}
 
-    /* fail to match a colon. this should never happen, but check anyways */
-    if (!(cpuinfo_line = strchr(cpuinfo_buf, ':'))) {
-      ERR_REPORT("Fatal error matching in /proc/cpuinfo");
-      return;
+/*	detect_topology
+  detects the computer's sockets, cores, SMT, cache hierarchy and hybrid
+  core split from sysfs
+*/
+void detect_topology(void) {
+  struct topology t;
+  struct cpu_cache *c;
+  char caches[MAX_STRLEN];
+  char size[32];
+  char instances[16];
+  unsigned int i, level;
+  int len = 0;
+
+  if (!topology_read("/sys/devices/system/cpu", &t)) {
+    if (error)
+      ERR_REPORT("Could not read the CPU topology from /sys/devices/system/cpu.");
+    return;
+  }
+
+  field_set_int(FIELD_CPU_PACKAGES, t.sockets);
+  field_set_int(FIELD_CPU_CORE_COUNT, t.cores);
+  field_set_int(FIELD_CPU_THREAD_COUNT, t.threads);
+  field_set_int(FIELD_CPU_SMT, t.smt);
+
+  if (t.pcores && t.ecores) {
+    field_set_int(FIELD_CPU_PCORES, t.pcores);
+    field_set_int(FIELD_CPU_ECORES, t.ecores);
+  }
+
+  caches[0] = '\0';
+  for (level = 1; level <= 4; level++) {
+    bool first = true;
+
+    for (i = 0; i < t.n_caches && len < MAX_STRLEN; i++) {
+      c = &t.caches[i];
+      if (c->level != level)
+        continue;
+
+      format_cache_size(size, sizeof(size), c->size_kb);
+
+      /* caches private to a core are implied; otherwise show how many there are */
+      instances[0] = '\0';
+      if (c->shared_cpus > t.smt && c->instances > 1)
+        snprintf(instances, sizeof(instances), "%ux ", c->instances);
+
+      if (first)
+        len += snprintf(caches + len, MAX_STRLEN - len, "%sL%u %s%s", len ? ", " : "", level,
+                        instances, size);
+      else
+        len += snprintf(caches + len, MAX_STRLEN - len, "+%s%s", instances, size);
+      first = false;
     }
+  }
+
+  if (caches[0])
+    field_set_str(FIELD_CPU_CACHES, caches);
+
+  return;
+}
+
+static struct cpu_sample usage_start;
+static struct timespec usage_start_time;
+static bool usage_started = false;
+static bool usage_per_core = false;
+
+/*	detect_cpu_usage_begin
+  takes the first /proc/stat sample for detect_cpu_usage; called before the
+  other detection functions so that the sampling window overlaps them
+  argument bool per_core: whether to sample each CPU as well as the total
+*/
+void detect_cpu_usage_begin(bool per_core) {
+  usage_per_core = per_core;
+  clock_gettime(CLOCK_MONOTONIC, &usage_start_time);
+  usage_started = procstat_sample("/proc/stat", &usage_start, per_core);
+
+  return;
+}
+
+/*	detect_cpu_usage
+  detects the CPU utilisation since detect_cpu_usage_begin, waiting until
+  at least interval_ms milliseconds have passed since the first sample
+*/
+void detect_cpu_usage(unsigned int interval_ms) {
+  struct cpu_sample now;
+  struct timespec end, wait;
+  long long remaining;
+  char core[16];
+  unsigned int i, j;
+  int usage;
+
+  if (!usage_started) {
+    if (error)
+      ERR_REPORT("Could not read CPU times from /proc/stat.");
+    return;
+  }
 
-    cpuinfo_line += 2;
-    end = strlen(cpuinfo_line);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  remaining = (long long)interval_ms * 1000000 -
+              ((long long)(end.tv_sec - usage_start_time.tv_sec) * 1000000000 +
+               (end.tv_nsec - usage_start_time.tv_nsec));
 
-    if (cpuinfo_line[end - 1] == '\n')
-      cpuinfo_line[end - 1] = '\0';
+  if (remaining > 0) {
+    wait.tv_sec = remaining / 1000000000;
+    wait.tv_nsec = remaining % 1000000000;
+    while (nanosleep(&wait, &wait) == -1 && errno == EINTR)
+      ;
+  }
+
+  if (!procstat_sample("/proc/stat", &now, usage_per_core)) {
+    procstat_free(&usage_start);
+    if (error)
+      ERR_REPORT("Could not read CPU times from /proc/stat.");
+    return;
+  }
 
-    if (STREQ(cpuinfo_line, "ARMv6-compatible processor rev 7 (v6l)")) {
-      safe_strncpy(cpu_str, "BCM2708 (Raspberry Pi)", MAX_STRLEN);
-    } else {
-      safe_strncpy(cpu_str, cpuinfo_line, MAX_STRLEN);
+  /* a window shorter than a clock tick measures nothing, which is not 0% */
+  if ((usage = procstat_usage(&usage_start.all, &now.all)) >= 0)
+    field_set_real(FIELD_CPU_USAGE, usage);
+
+  if (usage >= 0 && usage_per_core) {
+    /* CPUs can go offline between samples, so match them up by id */
+    for (i = 0, j = 0; i < now.n_cpus; i++) {
+      while (j < usage_start.n_cpus && usage_start.cpus[j].id < now.cpus[i].id)
+        j++;
+      if (j == usage_start.n_cpus || usage_start.cpus[j].id != now.cpus[i].id)
+        continue;
+
+      if ((usage = procstat_usage(&usage_start.cpus[j], &now.cpus[i])) < 0)
+        continue;
+      snprintf(core, sizeof(core), "%d%%", usage);
+      field_list_add(FIELD_CPU_CORES, core);
     }
-  } else if (error) {
-    ERR_REPORT("Failed to open /proc/cpuinfo. Ancient Linux kernel?");
   }
 
+  procstat_free(&usage_start);
+  procstat_free(&now);
+  usage_started = false;
+
   return;
 }
 
@@ -354,14 +423,15 @@ void detect_gpu(void) {
   XVisualInfo *visual_info = NULL;
   GLXContext context = NULL;
 
-  if ((disp = XOpenDisplay(NULL))) {
+  if ((disp = x11_display())) {
     wind = DefaultRootWindow(disp);
 
     if ((visual_info = glXChooseVisual(disp, 0, attr))) {
       if ((context = glXCreateContext(disp, visual_info, NULL, GL_TRUE))) {
         glXMakeCurrent(disp, wind, context);
-        safe_strncpy(gpu_str, (const char *)glGetString(GL_RENDERER), MAX_STRLEN);
+        field_set_str(FIELD_GPU, (const char *)glGetString(GL_RENDERER));
 
+        glXMakeCurrent(disp, None, NULL);
         glXDestroyContext(disp, context);
       } else if (error) {
         ERR_REPORT("Failed to create OpenGL context.");
@@ -371,10 +441,7 @@ void detect_gpu(void) {
     } else if (error) {
       ERR_REPORT("Failed to select a proper X visual.");
     }
-
-    XCloseDisplay(disp);
   } else if (error) {
-    safe_strncpy(gpu_str, "No X Server", MAX_STRLEN);
     ERR_REPORT("Could not open an X display (detect_gpu).");
   }
 
@@ -382,76 +449,132 @@ void detect_gpu(void) {
 }
 
 /*	detect_disk
-  detects the computer's total disk capacity and usage
+  detects the computer's total disk capacity and usage, counting each
+  filesystem once however many times it is mounted
+  argument bool per_fs: whether to list each filesystem's usage as well,
+  network filesystems included
+  --
+  CAVEAT: filesystems that do not answer statvfs() in time (a dead NFS server,
+  a failing disk) are left out of the total and reported as unresponsive
+  --
 */
-void detect_disk(void) {
-  FILE *mnt_file;
-  struct mntent *ent;
-  struct statvfs fs;
-  unsigned long long disk_total = 0, disk_used = 0, disk_pct = 0;
-
-  if ((mnt_file = setmntent("/etc/mtab", "r"))) {
-    while ((ent = getmntent(mnt_file))) {
-      /* we only want to get the size of "real" disks (starting with /) */
-      if (ent->mnt_dir && ent->mnt_fsname && ent->mnt_fsname[0] == '/') {
-        if (!statvfs(ent->mnt_dir, &fs)) {
-          disk_total += (fs.f_blocks * fs.f_bsize);
-          disk_used += ((fs.f_blocks - fs.f_bfree) * fs.f_bsize);
-        } else {
-          ERR_REPORT("Could not stat filesystem for statistics (detect_disk).");
-        }
-      }
+void detect_disk(bool per_fs) {
+  struct fs_usage *fs;
+  unsigned long long disk_total = 0, disk_used = 0;
+  unsigned int unresponsive = 0;
+  char mount[MAX_STRLEN], used[32], total[32];
+  int n, i, len;
+
+  if ((n = mounts_read("/proc/self/mountinfo", per_fs, &fs)) < 0) {
+    if (error)
+      ERR_REPORT("Could not read /proc/self/mountinfo (detect_disk).");
+    return;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (fs[i].unresponsive) {
+      unresponsive++;
+    } else if (!fs[i].remote) {
+      disk_total += fs[i].total;
+      disk_used += fs[i].used;
+    }
+  }
+
+  field_set_int(FIELD_DISK_TOTAL, disk_total);
+  field_set_int(FIELD_DISK_USED, disk_used);
+
+  if (per_fs) {
+    for (i = 0; i < n; i++) {
+      /* in the Disk row's units; a mount point too long to show is left out */
+      fields_format_bytes(used, sizeof(used), fs[i].used, field_defs[FIELD_DISK_USED].scale);
+      fields_format_bytes(total, sizeof(total), fs[i].total, field_defs[FIELD_DISK_TOTAL].scale);
+      if (fs[i].unresponsive)
+        len = snprintf(mount, MAX_STRLEN, "%s unresponsive", fs[i].mount_point);
+      else
+        len = snprintf(mount, MAX_STRLEN, "%s %s/%s", fs[i].mount_point, used, total);
+      if (len < MAX_STRLEN)
+        field_list_add(FIELD_DISK_MOUNTS, mount);
     }
+  } else if (unresponsive > 0) {
+    snprintf(mount, MAX_STRLEN, "%u unresponsive", unresponsive);
+    field_list_add(FIELD_DISK_MOUNTS, mount);
+  }
 
-    disk_total /= GB;
-    disk_used /= GB;
-    disk_pct = disk_total > 0 ? (disk_used * 100 / disk_total) : 0;
+  free(fs);
 
-    snprintf(disk_str, MAX_STRLEN, "%llu%s / %llu%s (%llu%%)", disk_used, "GiB", disk_total, "GiB",
-             disk_pct);
+  return;
+}
 
-    endmntent(mnt_file);
-  } else if (error) {
-    ERR_REPORT("Could not open /etc/mtab (detect_disk).");
+/*	mem_limits
+  detects the memory limit that the cgroups of the process whose cgroup
+  file is at proc_cgroup put on it, noting it and the cgroup's usage next
+  to the host's memory
+*/
+static void mem_limits(const char *proc_cgroup) {
+  struct cgroup_limits cg;
+  char used[64], limit[64], note[MAX_STRLEN];
+
+  if (!cgroup_read(CGROUP_MOUNT, proc_cgroup, CGROUP_MEMORY, &cg))
+    return;
+
+  if (cg.mem_current >= 0)
+    field_set_int(FIELD_MEM_CGROUP_USED, cg.mem_current);
+
+  if (cg.mem_max < 0)
+    return;
+
+  field_set_int(FIELD_MEM_LIMIT, cg.mem_max);
+  fields_format_bytes(limit, sizeof(limit), cg.mem_max, field_defs[FIELD_MEM_LIMIT].scale);
+
+  if (cg.mem_current >= 0 && cg.mem_max > 0) {
+    fields_format_bytes(used, sizeof(used), cg.mem_current, field_defs[FIELD_MEM_LIMIT].scale);
+    snprintf(note, MAX_STRLEN, "cgroup %s / %s (%lld%%)", used, limit,
+             cg.mem_current * 100 / cg.mem_max);
+  } else {
+    snprintf(note, MAX_STRLEN, "cgroup limit %s", limit);
   }
 
-  return;
+  field_list_add(FIELD_MEM_CGROUP, note);
 }
 
 /*	detect_mem
-  detects the computer's total and used RAM
+  detects the computer's total and used RAM, along with swap, zram
+  compression and hugepage usage
 */
 void detect_mem(void) {
-  long long memtotal = 0, shmem = 0, memavailable = 0, sunreclaim = 0;
-  long long total_mem, used_mem, mem_pct;
-  FILE *fp;
-  char line[64];
-
-  if ((fp = fopen("/proc/meminfo", "r"))) {
-    while (fgets(line, 64, fp)) {
-      if (strncmp(line, "MemTotal:", 9) == 0) {
-        sscanf(line + 9, "%lld", &memtotal);
-      } else if (strncmp(line, "Shmem:", 6) == 0) {
-        sscanf(line + 6, "%lld", &shmem);
-      } else if (strncmp(line, "MemAvailable:", 13) == 0) {
-        sscanf(line + 13, "%lld", &memavailable);
-      } else if (strncmp(line, "SUnreclaim:", 11) == 0) {
-        sscanf(line + 11, "%lld", &sunreclaim);
-      }
-    }
-    fclose(fp);
-  } else {
+  struct meminfo mi;
+  struct zram_stat zs;
+  char extra[MAX_STRLEN];
+
+  mem_limits(target_cgroup);
+
+  if (!meminfo_read("/proc/meminfo", &mi)) {
     ERR_REPORT("Failed to open /proc/meminfo. Ancient Linux kernel?");
+    return;
+  }
+
+  field_set_int(FIELD_MEM_TOTAL, (long long)mi.mem_total * KB);
+  field_set_int(FIELD_MEM_USED, (long long)(mi.mem_total - mi.mem_available) * KB);
+  field_set_int(FIELD_SWAP_TOTAL, (long long)mi.swap_total * KB);
+  field_set_int(FIELD_SWAP_USED, (long long)(mi.swap_total - mi.swap_free) * KB);
+
+  zram_read("/sys/block", &zs);
+
+  if (zs.devices > 0 && zs.compr_bytes > 0) {
+    snprintf(extra, MAX_STRLEN, "zram %.2fx", (double)zs.orig_bytes / zs.compr_bytes);
+    field_list_add(FIELD_SWAP_EXTRA, extra);
   }
 
-  total_mem = (memtotal + shmem) * 1000;
-  used_mem = total_mem - ((memavailable + sunreclaim) * 1000);
-  total_mem /= MB;
-  used_mem /= MB;
-  mem_pct = total_mem > 0 ? (used_mem * 100 / total_mem) : 0;
+  if (mi.huge_total > 0) {
+    snprintf(extra, MAX_STRLEN, "HugePages %llu / %llu (%lluKiB)", mi.huge_total - mi.huge_free,
+             mi.huge_total, mi.huge_size);
+    field_list_add(FIELD_SWAP_EXTRA, extra);
+  }
 
-  snprintf(mem_str, MAX_STRLEN, "%lld%s / %lld%s (%lld%%)", used_mem, "MiB", total_mem, "MiB",
-           mem_pct);
+  if (mi.anon_huge > 0) {
+    snprintf(extra, MAX_STRLEN, "THP %lluMiB", mi.anon_huge / KB);
+    field_list_add(FIELD_SWAP_EXTRA, extra);
+  }
 
   return;
 }
@@ -469,6 +592,12 @@ void detect_shell(void) {
   char *shell_name;
   char vers_str[MAX_STRLEN];
 
+  /* our $SHELL says nothing about the target's */
+  if (target_root[0]) {
+    sysroot_shell(target_root);
+    return;
+  }
+
   if (!(shell_name = getenv("SHELL"))) {
     if (error)
       ERR_REPORT("Could not detect a shell - $SHELL not defined.");
@@ -477,30 +606,30 @@ void detect_shell(void) {
   }
 
   if (STREQ(shell_name, "/bin/sh")) {
-    safe_strncpy(shell_str, "POSIX sh", MAX_STRLEN);
+    field_set_str(FIELD_SHELL, "POSIX sh");
   } else if (strstr(shell_name, "bash")) {
     shell_file = popen("bash --version | head -1", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "bash %.*s", 17, vers_str + 10);
+    field_printf(FIELD_SHELL, "bash %.*s", 17, vers_str + 10);
     pclose(shell_file);
   } else if (strstr(shell_name, "zsh")) {
     shell_file = popen("zsh --version", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "zsh %.*s", 5, vers_str + 4);
+    field_printf(FIELD_SHELL, "zsh %.*s", 5, vers_str + 4);
     pclose(shell_file);
   } else if (strstr(shell_name, "csh")) {
     shell_file = popen("csh --version | head -1", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "csh %.*s", 7, vers_str + 5);
+    field_printf(FIELD_SHELL, "csh %.*s", 7, vers_str + 5);
     pclose(shell_file);
   } else if (strstr(shell_name, "fish")) {
     shell_file = popen("fish --version", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "fish %.*s", 13, vers_str + 6);
+    field_printf(FIELD_SHELL, "fish %.*s", 13, vers_str + 6);
     pclose(shell_file);
   } else if (strstr(shell_name, "dash") || strstr(shell_name, "ash") || strstr(shell_name, "ksh")) {
     /* i don't have a version detection system for these, yet */
-    safe_strncpy(shell_str, shell_name, MAX_STRLEN);
+    field_set_str(FIELD_SHELL, shell_name);
   }
 
   return;
@@ -514,19 +643,14 @@ void detect_res(void) {
   Display *disp;
   Screen *screen;
 
-  if ((disp = XOpenDisplay(NULL))) {
+  if ((disp = x11_display())) {
     screen = XDefaultScreenOfDisplay(disp);
     width = WidthOfScreen(screen);
     height = HeightOfScreen(screen);
 
-    snprintf(res_str, MAX_STRLEN, "%dx%d", width, height);
-
-    XCloseDisplay(disp);
-  } else {
-    safe_strncpy(res_str, "No X Server", MAX_STRLEN);
-
-    if (error)
-      ERR_REPORT("Could not open an X display (detect_res)");
+    field_printf(FIELD_RES, "%dx%d", width, height);
+  } else if (error) {
+    ERR_REPORT("Could not open an X display (detect_res)");
   }
 
   return;
@@ -539,17 +663,17 @@ void detect_de(void) {
   char *curr_de;
 
   if ((curr_de = getenv("XDG_CURRENT_DESKTOP"))) {
-    safe_strncpy(de_str, curr_de, MAX_STRLEN);
+    field_set_str(FIELD_DE, curr_de);
   } else {
     if (getenv("GNOME_DESKTOP_SESSION_ID")) {
-      safe_strncpy(de_str, "Gnome", MAX_STRLEN);
+      field_set_str(FIELD_DE, "Gnome");
     } else if (getenv("MATE_DESKTOP_SESSION_ID")) {
-      safe_strncpy(de_str, "MATE", MAX_STRLEN);
+      field_set_str(FIELD_DE, "MATE");
     } else if (getenv("KDE_FULL_SESSION")) {
       /*	KDE_SESSION_VERSION only exists on KDE4+, so
         getenv will return NULL on KDE <= 3.
        */
-      snprintf(de_str, MAX_STRLEN, "KDE%s", getenv("KDE_SESSION_VERSION"));
+      field_printf(FIELD_DE, "KDE%s", getenv("KDE_SESSION_VERSION"));
     } else if (error) {
       ERR_REPORT("No desktop environment found.");
     }
@@ -570,7 +694,7 @@ void detect_wm(void) {
   char *wm_name = '\0';
   Window *wm_check_window;
 
-  if ((disp = XOpenDisplay(NULL))) {
+  if ((disp = x11_display())) {
     if (!(XGetWindowProperty(disp, DefaultRootWindow(disp),
                              XInternAtom(disp, "_NET_SUPPORTING_WM_CHECK", true), 0, KB, false,
                              XA_WINDOW, &actual_type, &actual_format, &nitems, &bytes,
@@ -579,7 +703,7 @@ void detect_wm(void) {
           !(XGetWindowProperty(disp, *wm_check_window, XInternAtom(disp, "_NET_WM_NAME", true), 0,
                                KB, false, XInternAtom(disp, "UTF8_STRING", true), &actual_type,
                                &actual_format, &nitems, &bytes, (unsigned char **)&wm_name))) {
-        safe_strncpy(wm_str, wm_name, MAX_STRLEN);
+        field_set_str(FIELD_WM, wm_name);
         XFree(wm_name);
       } else if (error) {
         ERR_REPORT("No _NET_WM_NAME property found.");
@@ -589,8 +713,6 @@ void detect_wm(void) {
     } else if (error) {
       ERR_REPORT("No WM detected (non-EWMH compliant?)");
     }
-
-    XCloseDisplay(disp);
   } else if (error) {
     ERR_REPORT("Could not open an X display. (detect_wm)");
   }
@@ -606,43 +728,44 @@ void detect_wm(void) {
   --
 */
 void detect_wm_theme(void) {
+  char theme[MAX_STRLEN] = "Unknown";
+  char wm[MAX_STRLEN];
   char exec_str[MAX_STRLEN] = "false";
   char config_file[MAX_STRLEN];
   char *home;
   FILE *wm_theme_file;
 
-  snprintf(wm_theme_str, MAX_STRLEN, "Unknown");
+  safe_strncpy(wm, field_str(FIELD_WM), MAX_STRLEN);
   home = getenv("HOME");
 
   if (!home) {
     ERR_REPORT("Environment variable HOME not set.");
   } else {
-    if (STREQ("Awesome", wm_str)) {
+    if (STREQ("Awesome", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.config/awesome/rc.lua", home);
       snprintf(exec_str, MAX_STRLEN,
                "grep -e '^[^-].*\\(theme\\|beautiful\\).*lua' '%s' | grep "
                "'[a-zA-Z0-9]\\+/[a-zA-Z0-9]\\+.lua' -o | head -n1 | cut -d'/' -f1",
                config_file);
-    } else if (STRCASEEQ("BlackBox", wm_str)) {
+    } else if (STRCASEEQ("BlackBox", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.blackboxrc", home);
       if (FILE_EXISTS(config_file)) {
         snprintf(exec_str, MAX_STRLEN, "awk -F\"/\" '/styleFile/ {print $NF}' '%s'", config_file);
       }
-    } else if (STREQ("Cinnamon", wm_str)) {
-      safe_strncpy(exec_str, "gsettings get org.cinnamon.theme name", MAX_STRLEN);
-    } else if (STREQ("Compiz", wm_str) || BEGINS_WITH(wm_str, "Mutter") ||
-               STREQ("GNOME Shell", wm_str)) {
-      if (command_in_path("gsettings")) {
-        safe_strncpy(exec_str, "gsettings get org.gnome.desktop.wm.preferences theme", MAX_STRLEN);
-      } else if (command_in_path("gconftool-2")) {
+    } else if (STREQ("Cinnamon", wm)) {
+      dconf_read_string("org.cinnamon.theme", "name", theme);
+    } else if (STREQ("Compiz", wm) || BEGINS_WITH(wm, "Mutter") ||
+               STREQ("GNOME Shell", wm)) {
+      if (!dconf_read_string("org.gnome.desktop.wm.preferences", "theme", theme) &&
+          command_in_path("gconftool-2")) {
         safe_strncpy(exec_str, "gconftool-2 -g /apps/metacity/general/theme", MAX_STRLEN);
       }
-    } else if (STREQ("E16", wm_str)) {
+    } else if (STREQ("E16", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.e16/e_config--0.0.cfg", home);
       if (FILE_EXISTS(config_file)) {
         snprintf(exec_str, MAX_STRLEN, "awk -F\"= \" '/theme.name/ {print $2}' '%s'", config_file);
       }
-    } else if (STREQ("E17", wm_str) || STREQ("Enlightenment", wm_str)) {
+    } else if (STREQ("E17", wm) || STREQ("Enlightenment", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.e/e/config/standard/e.cfg", home);
       if (FILE_EXISTS(config_file) && command_in_path("eet")) {
         snprintf(exec_str, MAX_STRLEN,
@@ -653,10 +776,10 @@ void detect_wm_theme(void) {
       } else {
         char *tmp = getenv("E_CONF_PROFILE");
         if (tmp) {
-          safe_strncpy(wm_theme_str, tmp, MAX_STRLEN);
+          safe_strncpy(theme, tmp, MAX_STRLEN);
         }
       }
-    } else if (STREQ("Emerald", wm_str)) {
+    } else if (STREQ("Emerald", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.emerald/theme/theme.ini", home);
       if (FILE_EXISTS(config_file)) {
         snprintf(exec_str, MAX_STRLEN,
@@ -665,78 +788,25 @@ void detect_wm_theme(void) {
                  "done",
                  home, config_file);
       }
-    } else if (STRCASEEQ("FluxBox", wm_str)) {
+    } else if (STRCASEEQ("FluxBox", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.fluxbox/init", home);
       if (FILE_EXISTS(config_file)) {
         snprintf(exec_str, MAX_STRLEN, "awk -F\"/\" '/styleFile/ {print $NF}' '%s'", config_file);
       }
-    } else if (STREQ("IceWM", wm_str)) {
+    } else if (STREQ("IceWM", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.icewm/theme", home);
       if (FILE_EXISTS(config_file)) {
         snprintf(exec_str, MAX_STRLEN, "awk -F\"[\\\",/]\" '!/#/ {print $2}' '%s'", config_file);
       }
-    } else if (BEGINS_WITH(wm_str, "KWin")) {
-      FILE *f = NULL;
-      char kde_config_dir[MAX_STRLEN] = "Unknown";
-      char kde_theme[MAX_STRLEN] = "Unknown";
-      char *env;
-      const char *kde_config_cmd = NULL;
-
-      env = getenv("KDE_CONFIG_DIR");
-      if (env) {
-        safe_strncpy(kde_config_dir, env, MAX_STRLEN);
-      } else {
-        if (command_in_path("kde5-config")) {
-          kde_config_cmd = "kde5-config --localprefix";
-        } else if (command_in_path("kde4-config")) {
-          kde_config_cmd = "kde4-config --localprefix";
-        }
-        if (command_in_path("kde-config")) {
-          kde_config_cmd = "kde-config --localprefix";
-        }
-
-        if (kde_config_cmd) {
-          f = popen(kde_config_cmd, "r");
-          fgets(kde_config_dir, MAX_STRLEN, f);
-          pclose(f);
-        }
-      }
-
-      if (!STREQ("Unknown", kde_config_dir)) {
-        snprintf(exec_str, MAX_STRLEN,
-                 "awk '/PluginLib=kwin3_/{gsub(/PluginLib=kwin3_/,\"\",$0); print $0; exit}' "
-                 "'%s/share/config/kwinrc'",
-                 kde_config_dir);
-        f = popen(exec_str, "r");
-        fgets(kde_theme, MAX_STRLEN, f);
-        pclose(f);
-
-        if (STREQ("", kde_theme) || STREQ("\n", kde_theme)) {
-          snprintf(config_file, MAX_STRLEN, "%s/share/config/kdebugrc", kde_config_dir);
-          if (FILE_EXISTS(config_file)) {
-            snprintf(exec_str, MAX_STRLEN,
-                     "awk '/(decoration)/ {gsub(/\\[/,\"\",$1); print $1; exit}' '%s'",
-                     config_file);
-            f = popen(exec_str, "r");
-            fgets(kde_theme, MAX_STRLEN, f);
-            pclose(f);
-
-            if (STREQ("", kde_theme) || STREQ("\n", kde_theme)) {
-              safe_strncpy(kde_theme, "Unknown", MAX_STRLEN);
-            }
-          }
-        }
-      }
-
-      safe_strncpy(exec_str, "false", MAX_STRLEN);
-      safe_strncpy(wm_theme_str, kde_theme, MAX_STRLEN);
-    } else if (STREQ("Marco", wm_str) || STREQ("Metacity (Marco)", wm_str)) {
-      safe_strncpy(exec_str, "gsettings get org.mate.Marco.general theme", MAX_STRLEN);
-    } else if (STREQ("Metacity", wm_str)) {
+    } else if (BEGINS_WITH(wm, "KWin")) {
+      kde_wm_theme(theme);
+    } else if (STREQ("Marco", wm) || STREQ("Metacity (Marco)", wm)) {
+      dconf_read_string("org.mate.Marco.general", "theme", theme);
+    } else if (STREQ("Metacity", wm)) {
       safe_strncpy(exec_str, "gconftool-2 -g /apps/metacity/general/theme 2>/dev/null", MAX_STRLEN);
-    } else if (STRCASEEQ("OpenBox", wm_str)) {
+    } else if (STRCASEEQ("OpenBox", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.config/openbox/lxde-rc.xml", home);
-      if (!(FILE_EXISTS(config_file) && STREQ(de_str, "LXDE"))) {
+      if (!(FILE_EXISTS(config_file) && STREQ(field_str(FIELD_DE), "LXDE"))) {
         config_file[0] = '\0';
       }
 
@@ -751,20 +821,20 @@ void detect_wm_theme(void) {
         snprintf(exec_str, MAX_STRLEN, "awk -F\"[<,>]\" '/<theme/ { getline; print $3 }' '%s'",
                  config_file);
       }
-    } else if (STREQ("PekWM", wm_str)) {
+    } else if (STREQ("PekWM", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.pekwm/config", home);
       if (FILE_EXISTS(config_file)) {
         snprintf(exec_str, MAX_STRLEN, "awk -F\"/\" '/Theme/ {gsub(/\\\"/,\"\"); print $NF}' '%s'",
                  config_file);
       }
-    } else if (STREQ("Sawfish", wm_str)) {
+    } else if (STREQ("Sawfish", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.sawfish/custom", home);
       if (FILE_EXISTS(config_file)) {
         snprintf(exec_str, MAX_STRLEN,
                  "awk -F\")\" '/\\(quote default-frame-style/{print $2}' '%s' | sed 's/ (quote //'",
                  config_file);
       }
-    } else if (STREQ("Xfwm4", wm_str)) {
+    } else if (STREQ("Xfwm4", wm)) {
       snprintf(config_file, MAX_STRLEN, "%s/.config/xfce4/xfconf/xfce-perchannel-xml/xfwm4.xml",
                home);
       if (FILE_EXISTS(config_file)) {
@@ -772,56 +842,44 @@ void detect_wm_theme(void) {
       }
     }
 
-    if (!STREQ(exec_str, "false") && STREQ(wm_theme_str, "Unknown")) {
+    if (!STREQ(exec_str, "false") && STREQ(theme, "Unknown")) {
       wm_theme_file = popen(exec_str, "r");
-      fgets(wm_theme_str, MAX_STRLEN, wm_theme_file);
+      fgets(theme, MAX_STRLEN, wm_theme_file);
       pclose(wm_theme_file);
 
-      if (STREQ("", wm_theme_str) || STREQ("\n", wm_theme_str)) {
-        safe_strncpy(wm_theme_str, "Unknown", MAX_STRLEN);
+      if (STREQ("", theme) || STREQ("\n", theme)) {
+        safe_strncpy(theme, "Unknown", MAX_STRLEN);
       }
-      unquote(wm_theme_str);
+      unquote(theme);
     }
   }
 
+  if (!STREQ(theme, "Unknown"))
+    field_set_str(FIELD_WM_THEME, theme);
+
   return;
 }
 
 /*	detect_gtk
-  detects the theme, icon(s), and font(s) associated with a GTK DE (if present)
-  --
-  CAVEAT: This function relies on the presence of 'detectgtk', a shell script.
-  If it isn't present somewhere in the PATH, the GTK will be set as 'Unknown'
-  --
+  detects the theme, icon(s), and font(s) associated with a GTK DE (if present),
+  leaving the ones that are not found undetected
 */
 void detect_gtk(void) {
-  FILE *gtk_file;
-  char exec_str[MAX_STRLEN];
-  char gtk2_str[MAX_STRLEN] = "Unknown";
-  char gtk3_str[MAX_STRLEN] = "Unknown";
-  char gtk_icons_str[MAX_STRLEN] = "Unknown";
-  char gtk_font_str[MAX_STRLEN] = "Unknown";
-
-  snprintf(exec_str, MAX_STRLEN, "detectgtk '%s' 2> /dev/null", de_str);
-  gtk_file = popen(exec_str, "r");
-  fscanf(gtk_file, "%s%s%s%s", gtk2_str, gtk3_str, gtk_icons_str, gtk_font_str);
-  pclose(gtk_file);
-
-  unquote(gtk2_str);
-  unquote(gtk3_str);
-  unquote(gtk_icons_str);
-  unquote(gtk_font_str);
-
-  if (STREQ(gtk3_str, "Unknown"))
-    snprintf(gtk_str, MAX_STRLEN, "%s (GTK2), %s (Icons)", gtk2_str, gtk_icons_str);
-  else if (STREQ(gtk2_str, "Unknown"))
-    snprintf(gtk_str, MAX_STRLEN, "%s (GTK3), %s (Icons)", gtk3_str, gtk_icons_str);
-  else
-    snprintf(gtk_str, MAX_STRLEN, "%s (GTK2), %s (GTK3)", gtk2_str, gtk3_str);
-
-  snprintf(icon_str, MAX_STRLEN, "%s", gtk_icons_str);
-
-  snprintf(font_str, MAX_STRLEN, "%s", gtk_font_str);
+  char gtk2_str[MAX_STRLEN] = "";
+  char gtk3_str[MAX_STRLEN] = "";
+  char gtk_icons_str[MAX_STRLEN] = "";
+  char gtk_font_str[MAX_STRLEN] = "";
+
+  gtk_read_settings(field_str(FIELD_DE), gtk2_str, gtk3_str, gtk_icons_str, gtk_font_str);
+
+  if (*gtk2_str)
+    field_set_str(FIELD_GTK2, gtk2_str);
+  if (*gtk3_str)
+    field_set_str(FIELD_GTK3, gtk3_str);
+  if (*gtk_icons_str)
+    field_set_str(FIELD_ICONS, gtk_icons_str);
+  if (*gtk_font_str)
+    field_set_str(FIELD_FONT, gtk_font_str);
 
   return;
 }
@@ -0,0 +1,322 @@
+/*	gtk.c
+**	-------------
+**
+**	A native reader for the GTK theme, icon theme and font settings
+**	that used to be gathered by the 'detectgtk' shell script.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+
+/* linux-specific includes */
+#include <unistd.h>
+
+/* program includes */
+#include "../../misc.h"
+#include "../../util.h"
+#include "dconf.h"
+#include "gtk.h"
+#include "kde.h"
+
+#define CONF_BUFSIZE (32 * KB)
+
+/*	skip_blank
+  returns a pointer to the first non-blank character of s
+*/
+static const char *skip_blank(const char *s) {
+  while (*s == ' ' || *s == '\t')
+    s++;
+
+  return s;
+}
+
+/*	copy_value
+  copies the value spanning [start, end) into out, trimming surrounding
+  whitespace and a single pair of matching quotes
+*/
+static void copy_value(const char *start, const char *end, char *out) {
+  size_t len;
+
+  start = skip_blank(start);
+  while (end > start && isspace((unsigned char)end[-1]))
+    end--;
+
+  if (end - start >= 2 && (*start == '"' || *start == '\'') && end[-1] == *start) {
+    start++;
+    end--;
+  }
+
+  len = end - start;
+  if (len >= MAX_STRLEN)
+    len = MAX_STRLEN - 1;
+
+  memcpy(out, start, len);
+  out[len] = '\0';
+}
+
+/*	conf_value
+  finds the first "key = value" line in buf and copies its value into out
+  returns true if the key was found with a non-empty value
+*/
+static bool conf_value(const char *buf, const char *key, char *out) {
+  size_t key_len = strlen(key);
+  const char *line, *end, *p;
+
+  for (line = buf; *line; line = *end ? end + 1 : end) {
+    if (!(end = strchr(line, '\n')))
+      end = line + strlen(line);
+
+    p = skip_blank(line);
+    if (strncmp(p, key, key_len))
+      continue;
+
+    p = skip_blank(p + key_len);
+    if (*p != '=')
+      continue;
+
+    copy_value(p + 1, end, out);
+    if (*out)
+      return true;
+  }
+
+  return false;
+}
+
+/*	xml_value
+  finds the element whose attribute name="name" appears in buf and copies
+  the contents of its value="..." attribute into out (xfconf channels)
+*/
+static bool xml_value(const char *buf, const char *name, char *out) {
+  char needle[MAX_STRLEN];
+  const char *p, *tag_end, *end;
+
+  snprintf(needle, MAX_STRLEN, "name=\"%s\"", name);
+
+  if (!(p = strstr(buf, needle)) || !(tag_end = strchr(p, '>')))
+    return false;
+
+  if (!(p = strstr(p, "value=\"")) || p > tag_end)
+    return false;
+
+  p += strlen("value=\"");
+  if (!(end = strchr(p, '"')) || end == p)
+    return false;
+
+  copy_value(p, end, out);
+  return true;
+}
+
+/*	rc_include_theme
+  extracts the theme name from an 'include ".../themes/NAME/gtk-2.0/gtkrc"'
+  line, as found in ~/.gtkrc.mine
+*/
+static bool rc_include_theme(const char *buf, char *out) {
+  const char *p, *end;
+
+  for (p = buf; (p = strstr(p, "include")); p++) {
+    if (p != buf && p[-1] != '\n')
+      continue;
+
+    end = strchr(p, '\n');
+    if (!end)
+      end = p + strlen(p);
+
+    if ((p = strstr(p, "/themes/")) && p < end) {
+      p += strlen("/themes/");
+      if ((end = strchr(p, '/')) && end != p) {
+        copy_value(p, end, out);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  return false;
+}
+
+/*	config_file
+  formats the path of a file below $XDG_CONFIG_HOME (or ~/.config) into path
+*/
+static void config_file(char *path, const char *name) {
+  const char *xdg = getenv("XDG_CONFIG_HOME");
+  const char *home = getenv("HOME");
+
+  if (xdg && *xdg)
+    snprintf(path, MAX_STRLEN, "%s/%s", xdg, name);
+  else
+    snprintf(path, MAX_STRLEN, "%s/.config/%s", home ? home : "", name);
+}
+
+/*	home_file
+  formats the path of a file below $HOME into path
+*/
+static void home_file(char *path, const char *name) {
+  const char *home = getenv("HOME");
+
+  snprintf(path, MAX_STRLEN, "%s/%s", home ? home : "", name);
+}
+
+/*	load
+  reads path into buf, returning false if it could not be read
+*/
+static bool load(const char *path, char *buf) {
+  if (read_file(path, buf, CONF_BUFSIZE) > 0)
+    return true;
+
+  buf[0] = '\0';
+  return false;
+}
+
+/*	query
+  runs a settings query tool (gconftool-2) and copies its first line of
+  output into out, stripped of surrounding quotes
+*/
+static void query(const char *cmd, char *out) {
+  char line[MAX_STRLEN];
+  FILE *f;
+
+  if (!(f = popen(cmd, "r")))
+    return;
+
+  if (fgets(line, MAX_STRLEN, f) && line[0] != '\n')
+    copy_value(line, line + strlen(line), out);
+
+  pclose(f);
+}
+
+/*	read_gtkrc
+  reads the GTK2 theme, icon theme and font from the first gtkrc that exists,
+  following the same precedence as GTK itself
+*/
+static void read_gtkrc(char *buf, char *gtk2, char *icons, char *font) {
+  char path[MAX_STRLEN];
+
+  home_file(path, ".gtkrc-2.0");
+  if (load(path, buf)) {
+    conf_value(buf, "gtk-theme-name", gtk2);
+    conf_value(buf, "gtk-icon-theme-name", icons);
+    conf_value(buf, "gtk-font-name", font);
+    return;
+  }
+
+  home_file(path, ".gtkrc.mine");
+  if (load(path, buf)) {
+    rc_include_theme(buf, gtk2);
+    conf_value(buf, "gtk-icon-theme-name", icons);
+    return;
+  }
+
+  if (load("/usr/share/gtk-2.0/gtkrc", buf)) {
+    conf_value(buf, "gtk-theme-name", gtk2);
+    conf_value(buf, "gtk-icon-theme-name", icons);
+    conf_value(buf, "gtk-font-name", font);
+    return;
+  }
+
+  if (load("/etc/gtk-2.0/gtkrc", buf)) {
+    if (!conf_value(buf, "gtk-theme-name", gtk2))
+      conf_value(buf, "gtk-fallback-theme-name", gtk2);
+    if (!conf_value(buf, "gtk-icon-theme-name", icons))
+      conf_value(buf, "gtk-fallback-icon-theme", icons);
+    conf_value(buf, "gtk-font-name", font);
+  }
+}
+
+/*	gtk_read_settings
+  fills gtk2, gtk3, icons and font (each MAX_STRLEN bytes) with the GTK
+  settings of the desktop environment de, leaving unknown values untouched
+*/
+void gtk_read_settings(const char *de, char *gtk2, char *gtk3, char *icons, char *font) {
+  char buf[CONF_BUFSIZE];
+  char path[MAX_STRLEN];
+  char de_lower[MAX_STRLEN];
+  char *e;
+  size_t i;
+
+  for (i = 0; de[i] && i < MAX_STRLEN - 1; i++)
+    de_lower[i] = tolower((unsigned char)de[i]);
+  de_lower[i] = '\0';
+
+  buf[0] = '\0';
+
+  if (strstr(de_lower, "kde") || strstr(de_lower, "plasma")) {
+    kde_widget_style(gtk2);
+    kde_icon_theme(icons);
+    kde_font(font);
+
+    home_file(path, ".gtkrc-2.0");
+    if (load(path, buf)) {
+      conf_value(buf, "gtk-theme-name", gtk2);
+      conf_value(buf, "gtk-icon-theme-name", icons);
+      conf_value(buf, "gtk-font-name", font);
+    }
+
+    config_file(path, "gtk-3.0/settings.ini");
+    if (load(path, buf))
+      conf_value(buf, "gtk-theme-name", gtk3);
+  } else if (strstr(de_lower, "cinnamon") || strstr(de_lower, "gnome") ||
+             strstr(de_lower, "unity")) {
+    if (dconf_read_string("org.gnome.desktop.interface", "gtk-theme", gtk3)) {
+      dconf_read_string("org.gnome.desktop.interface", "icon-theme", icons);
+      dconf_read_string("org.gnome.desktop.interface", "font-name", font);
+      safe_strncpy(gtk2, gtk3, MAX_STRLEN);
+    } else if (command_in_path("gconftool-2")) {
+      query("gconftool-2 -g /desktop/gnome/interface/gtk_theme 2> /dev/null", gtk2);
+      query("gconftool-2 -g /desktop/gnome/interface/icon_theme 2> /dev/null", icons);
+      query("gconftool-2 -g /desktop/gnome/interface/font_name 2> /dev/null", font);
+    }
+  } else if (strstr(de_lower, "mate")) {
+    if (dconf_read_string("org.mate.interface", "gtk-theme", gtk3))
+      safe_strncpy(gtk2, gtk3, MAX_STRLEN);
+    dconf_read_string("org.mate.interface", "icon-theme", icons);
+    dconf_read_string("org.mate.interface", "font-name", font);
+  } else if (strstr(de_lower, "xfce")) {
+    config_file(path, "xfce4/xfconf/xfce-perchannel-xml/xsettings.xml");
+    if (load(path, buf)) {
+      xml_value(buf, "ThemeName", gtk2);
+      xml_value(buf, "IconThemeName", icons);
+      xml_value(buf, "FontName", font);
+    }
+  } else if (strstr(de_lower, "lxde")) {
+    config_file(path, "lxde/config");
+    if (!load(path, buf)) {
+      config_file(path, "lxsession/LXDE/desktop.conf");
+      load(path, buf);
+    }
+
+    if (*buf) {
+      conf_value(buf, "sNet/ThemeName", gtk2);
+      conf_value(buf, "sNet/IconThemeName", icons);
+      conf_value(buf, "sGtk/FontName", font);
+    }
+  } else {
+    /* lightweight or no DE found */
+    read_gtkrc(buf, gtk2, icons, font);
+
+    config_file(path, "gtk-3.0/settings.ini");
+    if (load(path, buf))
+      conf_value(buf, "gtk-theme-name", gtk3);
+
+    /* ROX-Filer keeps its own icon theme */
+    config_file(path, "rox.sourceforge.net/ROX-Filer/Options");
+    if (load(path, buf) && (e = strstr(buf, "name=\"icon_theme\">"))) {
+      const char *end;
+
+      e += strlen("name=\"icon_theme\">");
+      if ((end = strchr(e, '<')) && end != e)
+        copy_value(e, end, icons);
+    }
+
+    /* Enlightenment only tells us its icon theme */
+    if ((e = getenv("E_ICON_THEME")))
+      safe_strncpy(icons, e, MAX_STRLEN);
+  }
+
+  return;
+}
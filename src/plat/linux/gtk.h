@@ -0,0 +1,13 @@
+/*	gtk.h
+**	-------------
+**
+**	Function prototypes for gtk.c.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_GTK_H
+#define SCREENFETCH_C_GTK_H
+
+void gtk_read_settings(const char *de, char *gtk2, char *gtk3, char *icons, char *font);
+
+#endif /* SCREENFETCH_C_GTK_H */
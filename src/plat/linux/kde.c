@@ -0,0 +1,264 @@
+/*	kde.c
+**	-------------
+**
+**	A native reader for KDE's INI-style configuration files (kwinrc, kdeglobals).
+**	Each file is located without running kde*-config, read once, and indexed
+**	by section and key; all later queries are answered from that index.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* linux-specific includes */
+#include <unistd.h>
+
+/* program includes */
+#include "../../misc.h"
+#include "../../util.h"
+#include "kde.h"
+
+#define KDE_BUFSIZE (64 * KB)
+#define KDE_MAX_FILES 4
+
+struct kde_entry {
+  const char *section;
+  const char *key;
+  const char *value;
+};
+
+struct kde_file {
+  const char *name;
+  char *buf;
+  struct kde_entry *entries;
+  size_t n_entries;
+};
+
+static struct kde_file kde_files[KDE_MAX_FILES];
+
+/*	trim
+  strips leading and trailing whitespace from s in place
+*/
+static char *trim(char *s) {
+  char *end;
+
+  while (*s == ' ' || *s == '\t')
+    s++;
+
+  end = s + strlen(s);
+  while (end > s && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+    *--end = '\0';
+
+  return s;
+}
+
+/*	kde_find_file
+  locates name in the KDE configuration directories, in order of precedence:
+  $KDE_CONFIG_DIR/share/config, $XDG_CONFIG_HOME (or ~/.config),
+  $KDEHOME/share/config, ~/.kde4/share/config and ~/.kde/share/config
+*/
+static bool kde_find_file(const char *name, char *path) {
+  const char *env;
+  const char *home = getenv("HOME");
+
+  if ((env = getenv("KDE_CONFIG_DIR")) && *env) {
+    snprintf(path, MAX_STRLEN, "%s/share/config/%s", env, name);
+    if (FILE_EXISTS(path))
+      return true;
+  }
+
+  if ((env = getenv("XDG_CONFIG_HOME")) && *env)
+    snprintf(path, MAX_STRLEN, "%s/%s", env, name);
+  else
+    snprintf(path, MAX_STRLEN, "%s/.config/%s", home ? home : "", name);
+  if (FILE_EXISTS(path))
+    return true;
+
+  if ((env = getenv("KDEHOME")) && *env) {
+    snprintf(path, MAX_STRLEN, "%s/share/config/%s", env, name);
+    if (FILE_EXISTS(path))
+      return true;
+  }
+
+  if (home) {
+    snprintf(path, MAX_STRLEN, "%s/.kde4/share/config/%s", home, name);
+    if (FILE_EXISTS(path))
+      return true;
+
+    snprintf(path, MAX_STRLEN, "%s/.kde/share/config/%s", home, name);
+    if (FILE_EXISTS(path))
+      return true;
+  }
+
+  return false;
+}
+
+/*	kde_index
+  splits the file's buffer into lines in place and records every
+  key=value pair along with the [section] it belongs to
+*/
+static void kde_index(struct kde_file *f) {
+  const char *section = "";
+  size_t cap = 0;
+  char *line, *next, *eq, *key, *flag;
+
+  for (line = f->buf; line && *line; line = next) {
+    if ((next = strchr(line, '\n')))
+      *next++ = '\0';
+
+    line = trim(line);
+
+    if (*line == '[') {
+      /* KDE nests groups as [A][B]; keep the full header as the section name */
+      char *end = strrchr(line, ']');
+
+      if (end) {
+        *end = '\0';
+        section = line + 1;
+      }
+      continue;
+    }
+
+    if (*line == '#' || !(eq = strchr(line, '=')))
+      continue;
+
+    *eq = '\0';
+    key = trim(line);
+
+    /* drop immutability/expansion flags such as key[$e]; keep localized keys distinct */
+    if ((flag = strstr(key, "[$")))
+      *flag = '\0';
+
+    if (f->n_entries == cap) {
+      struct kde_entry *grown;
+
+      cap = cap ? cap * 2 : 64;
+      if (!(grown = realloc(f->entries, cap * sizeof(*grown))))
+        return;
+      f->entries = grown;
+    }
+
+    f->entries[f->n_entries].section = section;
+    f->entries[f->n_entries].key = key;
+    f->entries[f->n_entries].value = trim(eq + 1);
+    f->n_entries++;
+  }
+}
+
+/*	kde_open
+  returns the parsed index for the named configuration file, reading and
+  indexing it on first use; returns NULL if the file does not exist
+*/
+static struct kde_file *kde_open(const char *name) {
+  char path[MAX_STRLEN];
+  int i;
+
+  for (i = 0; i < KDE_MAX_FILES && kde_files[i].name; i++) {
+    if (STREQ(kde_files[i].name, name))
+      return kde_files[i].buf ? &kde_files[i] : NULL;
+  }
+
+  if (i == KDE_MAX_FILES)
+    return NULL;
+
+  kde_files[i].name = name;
+
+  if (!kde_find_file(name, path) || !(kde_files[i].buf = malloc(KDE_BUFSIZE)))
+    return NULL;
+
+  if (read_file(path, kde_files[i].buf, KDE_BUFSIZE) <= 0) {
+    free(kde_files[i].buf);
+    kde_files[i].buf = NULL;
+    return NULL;
+  }
+
+  kde_index(&kde_files[i]);
+  return &kde_files[i];
+}
+
+/*	kde_config_value
+  copies the value of key in [section] of the KDE configuration file into out
+  returns true if the key exists with a non-empty value
+*/
+bool kde_config_value(const char *file, const char *section, const char *key, char *out) {
+  struct kde_file *f;
+  size_t i;
+
+  if (!(f = kde_open(file)))
+    return false;
+
+  /* later entries override earlier ones, as in KConfig */
+  for (i = f->n_entries; i-- > 0;) {
+    if (STREQ(f->entries[i].key, key) && STREQ(f->entries[i].section, section) &&
+        *f->entries[i].value) {
+      safe_strncpy(out, f->entries[i].value, MAX_STRLEN);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/*	kde_wm_theme
+  copies the KWin window decoration into out, if one is configured
+*/
+void kde_wm_theme(char *out) {
+  char value[MAX_STRLEN];
+  const char *name = value;
+
+  if (kde_config_value("kwinrc", "org.kde.kdecoration2", "theme", value)) {
+    /* Aurorae themes are stored as __aurorae__svg__NAME */
+    if (BEGINS_WITH(value, "__aurorae__svg__"))
+      name += strlen("__aurorae__svg__");
+  } else if (kde_config_value("kwinrc", "org.kde.kdecoration2", "library", value)) {
+    if (BEGINS_WITH(value, "org.kde."))
+      name += strlen("org.kde.");
+  } else if (kde_config_value("kwinrc", "Style", "PluginLib", value)) {
+    if (BEGINS_WITH(value, "kwin3_"))
+      name += strlen("kwin3_");
+  } else {
+    return;
+  }
+
+  safe_strncpy(out, name, MAX_STRLEN);
+}
+
+/*	kde_widget_style
+  copies the Qt widget style (or, failing that, the color scheme) into out
+*/
+void kde_widget_style(char *out) {
+  if (!kde_config_value("kdeglobals", "KDE", "widgetStyle", out) &&
+      !kde_config_value("kdeglobals", "General", "widgetStyle", out) &&
+      !kde_config_value("kdeglobals", "General", "ColorScheme", out))
+    kde_config_value("kdeglobals", "General", "colorScheme", out);
+}
+
+/*	kde_icon_theme
+  copies the icon theme into out
+*/
+void kde_icon_theme(char *out) {
+  kde_config_value("kdeglobals", "Icons", "Theme", out);
+}
+
+/*	kde_font
+  copies the general font into out, formatted as "Family Size"
+  KDE stores fonts as QFont strings: "Family,size,pixelsize,hint,weight,..."
+*/
+void kde_font(char *out) {
+  char value[MAX_STRLEN];
+  char *size, *end;
+
+  if (!kde_config_value("kdeglobals", "General", "font", value))
+    return;
+
+  /* the family and size are the first two fields: join them in place */
+  if ((size = strchr(value, ',')) && (end = strchr(size + 1, ','))) {
+    *size = ' ';
+    *end = '\0';
+  }
+
+  safe_strncpy(out, value, MAX_STRLEN);
+}
@@ -0,0 +1,19 @@
+/*	kde.h
+**	-------------
+**
+**	Function prototypes for kde.c.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_KDE_H
+#define SCREENFETCH_C_KDE_H
+
+#include <stdbool.h>
+
+bool kde_config_value(const char *file, const char *section, const char *key, char *out);
+void kde_wm_theme(char *out);
+void kde_widget_style(char *out);
+void kde_icon_theme(char *out);
+void kde_font(char *out);
+
+#endif /* SCREENFETCH_C_KDE_H */
@@ -0,0 +1,158 @@
+/*	meminfo.c
+**	-------------
+**
+**	Reads /proc/meminfo with a single read() into a fixed buffer and picks
+**	out the interesting keys through a perfect hash table, so that each line
+**	costs one hash and at most one comparison. Also sums up the compression
+**	statistics of any zram devices.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* linux-specific includes */
+#include <dirent.h>
+
+/* program includes */
+#include "../../misc.h"
+#include "../../util.h"
+#include "../../disp.h"
+#include "../../error_flag.h"
+#include "meminfo.h"
+
+#define MEMINFO_BUFSIZE (8 * KB)
+#define MEMINFO_SLOTS 32
+
+struct meminfo_key {
+  const char *name;
+  size_t offset;
+};
+
+static const struct meminfo_key meminfo_keys[] = {
+    {"MemTotal", offsetof(struct meminfo, mem_total)},
+    {"MemAvailable", offsetof(struct meminfo, mem_available)},
+    {"Shmem", offsetof(struct meminfo, shmem)},
+    {"SUnreclaim", offsetof(struct meminfo, sunreclaim)},
+    {"Cached", offsetof(struct meminfo, cached)},
+    {"Dirty", offsetof(struct meminfo, dirty)},
+    {"SwapTotal", offsetof(struct meminfo, swap_total)},
+    {"SwapFree", offsetof(struct meminfo, swap_free)},
+    {"AnonHugePages", offsetof(struct meminfo, anon_huge)},
+    {"HugePages_Total", offsetof(struct meminfo, huge_total)},
+    {"HugePages_Free", offsetof(struct meminfo, huge_free)},
+    {"HugePages_Rsvd", offsetof(struct meminfo, huge_rsvd)},
+    {"HugePages_Surp", offsetof(struct meminfo, huge_surp)},
+    {"Hugepagesize", offsetof(struct meminfo, huge_size)},
+};
+
+static const struct meminfo_key *meminfo_slots[MEMINFO_SLOTS];
+static bool meminfo_slots_ready = false;
+
+/*	meminfo_hash
+  a hash that is collision-free over meminfo_keys; any key added to the
+  table must keep it that way (meminfo_slots_init reports a clash)
+*/
+static unsigned int meminfo_hash(const char *key, size_t len) {
+  return (unsigned int)(len + (unsigned char)key[0] + 3 * (unsigned char)key[len - 1]) %
+         MEMINFO_SLOTS;
+}
+
+/*	meminfo_slots_init
+  places every key in its hash slot
+*/
+static void meminfo_slots_init(void) {
+  const struct meminfo_key *k;
+  unsigned int h;
+  size_t i;
+
+  for (i = 0; i < sizeof(meminfo_keys) / sizeof(meminfo_keys[0]); i++) {
+    k = &meminfo_keys[i];
+    h = meminfo_hash(k->name, strlen(k->name));
+
+    if (meminfo_slots[h] && error)
+      ERR_REPORT("meminfo key hash collision; adjust meminfo_hash.");
+
+    meminfo_slots[h] = k;
+  }
+
+  meminfo_slots_ready = true;
+}
+
+/*	meminfo_read
+  fills mi from the meminfo file at path (normally /proc/meminfo)
+  returns false if the file could not be read
+*/
+bool meminfo_read(const char *path, struct meminfo *mi) {
+  char buf[MEMINFO_BUFSIZE];
+  const struct meminfo_key *k;
+  char *line, *eol, *colon, *end;
+  ssize_t len;
+
+  memset(mi, 0, sizeof(*mi));
+
+  if (!meminfo_slots_ready)
+    meminfo_slots_init();
+
+  if ((len = read_file(path, buf, sizeof(buf))) <= 0)
+    return false;
+
+  end = buf + len;
+
+  for (line = buf; line < end; line = eol + 1) {
+    if (!(eol = memchr(line, '\n', end - line)))
+      eol = end;
+
+    if (!(colon = memchr(line, ':', eol - line)) || colon == line)
+      continue;
+
+    k = meminfo_slots[meminfo_hash(line, colon - line)];
+    if (k && !strncmp(k->name, line, colon - line) && !k->name[colon - line])
+      *(unsigned long long *)((char *)mi + k->offset) = strtoull(colon + 1, NULL, 10);
+  }
+
+  return true;
+}
+
+/*	zram_read
+  sums the original and compressed data sizes of every zram device found
+  in the block device directory sys_block (normally /sys/block)
+*/
+void zram_read(const char *sys_block, struct zram_stat *zs) {
+  char path[MAX_STRLEN];
+  char buf[256];
+  unsigned long long orig, compr;
+  struct dirent *ent;
+  char *p;
+  DIR *dir;
+
+  memset(zs, 0, sizeof(*zs));
+
+  if (!(dir = opendir(sys_block)))
+    return;
+
+  while ((ent = readdir(dir))) {
+    if (!BEGINS_WITH(ent->d_name, "zram"))
+      continue;
+
+    snprintf(path, MAX_STRLEN, "%s/%s/mm_stat", sys_block, ent->d_name);
+    if (read_file(path, buf, sizeof(buf)) <= 0)
+      continue;
+
+    /* mm_stat: orig_data_size compr_data_size mem_used_total ... */
+    orig = strtoull(buf, &p, 10);
+    compr = strtoull(p, NULL, 10);
+
+    if (orig > 0) {
+      zs->devices++;
+      zs->orig_bytes += orig;
+      zs->compr_bytes += compr;
+    }
+  }
+
+  closedir(dir);
+}
@@ -0,0 +1,41 @@
+/*	meminfo.h
+**	-------------
+**
+**	The memory, swap and hugepage figures read from /proc/meminfo and zram,
+**	and their readers' prototypes.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_MEMINFO_H
+#define SCREENFETCH_C_MEMINFO_H
+
+#include <stdbool.h>
+
+/* sizes are in KiB, as in /proc/meminfo; the HugePages_* fields are page counts */
+struct meminfo {
+  unsigned long long mem_total;
+  unsigned long long mem_available;
+  unsigned long long shmem;
+  unsigned long long sunreclaim;
+  unsigned long long cached;
+  unsigned long long dirty;
+  unsigned long long swap_total;
+  unsigned long long swap_free;
+  unsigned long long anon_huge;
+  unsigned long long huge_total;
+  unsigned long long huge_free;
+  unsigned long long huge_rsvd;
+  unsigned long long huge_surp;
+  unsigned long long huge_size;
+};
+
+struct zram_stat {
+  unsigned int devices;
+  unsigned long long orig_bytes;
+  unsigned long long compr_bytes;
+};
+
+bool meminfo_read(const char *path, struct meminfo *mi);
+void zram_read(const char *sys_block, struct zram_stat *zs);
+
+#endif /* SCREENFETCH_C_MEMINFO_H */
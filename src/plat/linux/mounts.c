@@ -0,0 +1,481 @@
+/*	mounts.c
+**	-------------
+**
+**	Disk accounting driven by /proc/self/mountinfo. Every mount already
+**	carries its device number there, so bind mounts and repeated mounts of
+**	one filesystem are collapsed without a single syscall, and statvfs() is
+**	only called once per distinct filesystem. btrfs subvolumes, which each
+**	get their own anonymous device, are further merged by filesystem UUID.
+**	statvfs() and the btrfs UUID probe run in a few disposable worker threads
+**	with a deadline for the whole batch, so a dead NFS or CIFS server cannot
+**	hang the whole program.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* linux-specific includes */
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/statvfs.h>
+#include <linux/btrfs.h>
+
+/* program includes */
+#include "../../misc.h"
+#include "../../util.h"
+#include "mounts.h"
+
+struct mount_entry {
+  uint64_t dev; /* major << 32 | minor */
+  const char *mount_point;
+  const char *fstype;
+  unsigned int order; /* position in mountinfo, to keep the output stable */
+  bool remote;
+};
+
+/* the statvfs() calls of one mounts_read(), shared with its workers; the
+   last of them (caller included) to let go frees it, since a worker stuck on
+   a dead server may outlive the caller by any amount of time */
+struct statvfs_batch {
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  unsigned int refs;
+  unsigned int pending;
+  unsigned int next; /* the first job no worker has taken yet */
+  unsigned int n_jobs;
+  bool abandoned; /* the caller gave up waiting: take no more jobs */
+  struct statvfs_job *jobs;
+};
+
+struct statvfs_job {
+  char path[MAX_STRLEN];
+  struct statvfs st;
+  unsigned char fsid[BTRFS_FSID_SIZE];
+  bool btrfs;
+  bool has_fsid;
+  bool done;
+  bool ok;
+};
+
+/* filesystems that never hold user data, or (autofs) must not be touched
+   lest the automounter fire; everything else with a device source counts */
+static const char *const pseudo_fstypes[] = {
+    "autofs", "binfmt_misc", "bpf",   "cgroup",  "cgroup2",  "configfs", "debugfs",
+    "devpts", "devtmpfs",    "fusectl", "hugetlbfs", "mqueue", "nsfs",   "overlay",
+    "proc",   "pstore",      "ramfs", "securityfs", "squashfs", "sysfs", "tmpfs",
+    "tracefs", "efivarfs",
+};
+
+/* network filesystems, whose statvfs() depends on a server answering */
+static const char *const remote_fstypes[] = {
+    "9p",  "afs",   "ceph",     "cifs",       "fuse.sshfs", "fuse.rclone", "glusterfs",
+    "lustre", "ncpfs", "nfs",   "nfs4",       "smb3",       "smbfs",
+};
+
+/*	is_pseudo
+  returns true if fstype is in pseudo_fstypes
+*/
+static bool is_pseudo(const char *fstype) {
+  size_t i;
+
+  for (i = 0; i < sizeof(pseudo_fstypes) / sizeof(pseudo_fstypes[0]); i++) {
+    if (STREQ(fstype, pseudo_fstypes[i]))
+      return true;
+  }
+
+  return false;
+}
+
+/*	is_remote
+  returns true if fstype is in remote_fstypes
+*/
+static bool is_remote(const char *fstype) {
+  size_t i;
+
+  for (i = 0; i < sizeof(remote_fstypes) / sizeof(remote_fstypes[0]); i++) {
+    if (STREQ(fstype, remote_fstypes[i]))
+      return true;
+  }
+
+  return false;
+}
+
+/*	next_field
+  NUL-terminates the space-separated field at *p and advances *p past it
+  returns the field, or NULL at the end of the line
+*/
+static char *next_field(char **p) {
+  char *field = *p, *end;
+
+  if (!*field)
+    return NULL;
+
+  if ((end = strchr(field, ' '))) {
+    *end = '\0';
+    *p = end + 1;
+  } else {
+    *p = field + strlen(field);
+  }
+
+  return field;
+}
+
+/*	unescape
+  decodes mountinfo's octal escapes (\040 for a space, etc.) in place
+*/
+static void unescape(char *s) {
+  char *out = s;
+
+  for (; *s; s++) {
+    if (s[0] == '\\' && s[1] >= '0' && s[1] <= '3' && s[2] >= '0' && s[2] <= '7' &&
+        s[3] >= '0' && s[3] <= '7') {
+      *out++ = (char)((s[1] - '0') << 6 | (s[2] - '0') << 3 | (s[3] - '0'));
+      s += 3;
+    } else {
+      *out++ = *s;
+    }
+  }
+
+  *out = '\0';
+}
+
+/*	cmp_dev, cmp_order
+  qsort comparators for mount entries
+*/
+static int cmp_dev(const void *a, const void *b) {
+  const struct mount_entry *x = a, *y = b;
+
+  if (x->dev != y->dev)
+    return x->dev < y->dev ? -1 : 1;
+  return (x->order > y->order) - (x->order < y->order);
+}
+
+static int cmp_order(const void *a, const void *b) {
+  const struct mount_entry *x = a, *y = b;
+
+  return (x->order > y->order) - (x->order < y->order);
+}
+
+/*	parse_mountinfo
+  splits buf (a mountinfo file) into entries for the mounts worth counting,
+  including network filesystems only if with_remote is set
+  returns the number of entries stored in *out, or -1 on allocation failure
+*/
+static int parse_mountinfo(char *buf, bool with_remote, struct mount_entry **out) {
+  struct mount_entry *entries = NULL, *grown;
+  size_t n = 0, cap = 0;
+  char *line, *next, *p, *field, *dev, *mount_point, *fstype, *source;
+  unsigned long major, minor;
+  bool remote;
+  int i;
+
+  for (line = buf; line && *line; line = next) {
+    if ((next = strchr(line, '\n')))
+      *next++ = '\0';
+
+    /* mount ID, parent ID, major:minor, root, mount point, options... */
+    p = line;
+    for (i = 0, dev = mount_point = NULL; i < 6 && (field = next_field(&p)); i++) {
+      if (i == 2)
+        dev = field;
+      else if (i == 4)
+        mount_point = field;
+    }
+
+    /* ...optional fields, then "-", the filesystem type and the source */
+    while ((field = next_field(&p)) && !STREQ(field, "-"))
+      ;
+
+    if (!field || !dev || !mount_point || !(fstype = next_field(&p)) ||
+        !(source = next_field(&p)))
+      continue;
+
+    /* only "real" disks have a device node as their source */
+    remote = is_remote(fstype);
+    if (remote ? !with_remote : (source[0] != '/' || is_pseudo(fstype)))
+      continue;
+
+    major = strtoul(dev, &p, 10);
+    if (*p != ':')
+      continue;
+    minor = strtoul(p + 1, NULL, 10);
+
+    if (n == cap) {
+      cap = cap ? cap * 2 : 64;
+      if (!(grown = realloc(entries, cap * sizeof(*grown)))) {
+        free(entries);
+        return -1;
+      }
+      entries = grown;
+    }
+
+    unescape(mount_point);
+    entries[n].dev = (uint64_t)major << 32 | minor;
+    entries[n].mount_point = mount_point;
+    entries[n].fstype = fstype;
+    entries[n].order = n;
+    entries[n].remote = remote;
+    n++;
+  }
+
+  *out = entries;
+  return (int)n;
+}
+
+/*	btrfs_fsid
+  reads the UUID of the btrfs filesystem mounted at mount_point into fsid
+*/
+static bool btrfs_fsid(const char *mount_point, unsigned char fsid[BTRFS_FSID_SIZE]) {
+  struct btrfs_ioctl_fs_info_args args;
+  int fd;
+  bool ok;
+
+  if ((fd = open(mount_point, O_RDONLY | O_DIRECTORY | O_CLOEXEC)) < 0)
+    return false;
+
+  memset(&args, 0, sizeof(args));
+  ok = !ioctl(fd, BTRFS_IOC_FS_INFO, &args);
+  close(fd);
+
+  if (ok)
+    memcpy(fsid, args.fsid, BTRFS_FSID_SIZE);
+
+  return ok;
+}
+
+/*	batch_release
+  drops one reference to batch, freeing it with the last one
+*/
+static void batch_release(struct statvfs_batch *batch) {
+  bool last;
+
+  pthread_mutex_lock(&batch->lock);
+  last = --batch->refs == 0;
+  pthread_mutex_unlock(&batch->lock);
+
+  if (last) {
+    pthread_mutex_destroy(&batch->lock);
+    pthread_cond_destroy(&batch->cond);
+    free(batch->jobs);
+    free(batch);
+  }
+}
+
+/*	statvfs_worker
+  takes jobs off the batch until none are left (or the caller has given up),
+  running each one's btrfs UUID probe and statvfs() outside the lock
+*/
+static void *statvfs_worker(void *arg) {
+  struct statvfs_batch *batch = arg;
+  struct statvfs_job *job;
+  struct statvfs st;
+  unsigned char fsid[BTRFS_FSID_SIZE];
+  bool ok, has_fsid;
+
+  pthread_mutex_lock(&batch->lock);
+  while (!batch->abandoned && batch->next < batch->n_jobs) {
+    job = &batch->jobs[batch->next++];
+    pthread_mutex_unlock(&batch->lock);
+
+    has_fsid = job->btrfs && btrfs_fsid(job->path, fsid);
+    ok = !statvfs(job->path, &st);
+
+    pthread_mutex_lock(&batch->lock);
+    job->st = st;
+    job->ok = ok;
+    if ((job->has_fsid = has_fsid))
+      memcpy(job->fsid, fsid, BTRFS_FSID_SIZE);
+    job->done = true;
+    batch->pending--;
+    pthread_cond_signal(&batch->cond);
+  }
+  pthread_mutex_unlock(&batch->lock);
+
+  batch_release(batch);
+  return NULL;
+}
+
+/*	batch_run
+  works through the batch on up to MOUNTS_MAX_WORKERS threads and waits until
+  every job is done or MOUNTS_TIMEOUT_MS has passed, whichever comes first;
+  the deadline is for the batch as a whole, and the jobs that are not done by
+  then (stuck or never started) are left to their (detached) threads
+*/
+static void batch_run(struct statvfs_batch *batch) {
+  pthread_attr_t attr;
+  pthread_t thread;
+  struct timespec deadline;
+  unsigned int i, started = 0;
+
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  pthread_attr_setstacksize(&attr, 64 * KB);
+
+  for (i = 0; i < batch->n_jobs && i < MOUNTS_MAX_WORKERS; i++) {
+    pthread_mutex_lock(&batch->lock);
+    batch->refs++;
+    pthread_mutex_unlock(&batch->lock);
+
+    if (pthread_create(&thread, &attr, statvfs_worker, batch))
+      batch_release(batch);
+    else
+      started++;
+  }
+
+  pthread_attr_destroy(&attr);
+
+  /* no thread to spare: do it inline and hope for the best */
+  if (started == 0 && batch->n_jobs > 0) {
+    pthread_mutex_lock(&batch->lock);
+    batch->refs++;
+    pthread_mutex_unlock(&batch->lock);
+    statvfs_worker(batch);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += MOUNTS_TIMEOUT_MS / 1000;
+  deadline.tv_nsec += (MOUNTS_TIMEOUT_MS % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  pthread_mutex_lock(&batch->lock);
+  while (batch->pending > 0 && !pthread_cond_timedwait(&batch->cond, &batch->lock, &deadline))
+    ;
+  batch->abandoned = true;
+  pthread_mutex_unlock(&batch->lock);
+}
+
+/*	batch_new
+  allocates a batch of n jobs, holding one reference for the caller
+*/
+static struct statvfs_batch *batch_new(unsigned int n) {
+  struct statvfs_batch *batch;
+  pthread_condattr_t attr;
+
+  if (!(batch = calloc(1, sizeof(*batch))))
+    return NULL;
+
+  if (n > 0 && !(batch->jobs = calloc(n, sizeof(*batch->jobs)))) {
+    free(batch);
+    return NULL;
+  }
+
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&batch->cond, &attr);
+  pthread_condattr_destroy(&attr);
+  pthread_mutex_init(&batch->lock, NULL);
+
+  batch->refs = 1;
+  batch->pending = n;
+  batch->n_jobs = n;
+
+  return batch;
+}
+
+/*	mounts_read
+  gathers the usage of every distinct disk-backed filesystem listed in the
+  mountinfo file at path (normally /proc/self/mountinfo), in mount order;
+  network filesystems are only included if with_remote is set, and any
+  filesystem that fails to answer in time is marked unresponsive
+  returns the number of filesystems stored in the malloc'd array *out,
+  or -1 if the file could not be read; the caller frees *out
+*/
+int mounts_read(const char *mountinfo, bool with_remote, struct fs_usage **out) {
+  struct mount_entry *entries;
+  struct fs_usage *fs = NULL;
+  struct statvfs_batch *batch;
+  struct statvfs_job *job;
+  unsigned char(*fsids)[BTRFS_FSID_SIZE] = NULL;
+  unsigned int n_fsids = 0;
+  char *buf;
+  int n, i, kept = 0;
+  unsigned int j;
+  bool dup;
+
+  *out = NULL;
+
+  if (!(buf = read_file_alloc(mountinfo, NULL)))
+    return -1;
+
+  if ((n = parse_mountinfo(buf, with_remote, &entries)) < 0) {
+    free(buf);
+    return -1;
+  }
+
+  /* keep the first mount of each device, then restore mount order */
+  qsort(entries, n, sizeof(*entries), cmp_dev);
+  for (i = 0; i < n; i++) {
+    if (i == 0 || entries[i].dev != entries[kept - 1].dev)
+      entries[kept++] = entries[i];
+  }
+  qsort(entries, kept, sizeof(*entries), cmp_order);
+
+  if (!(batch = batch_new(kept)) ||
+      (kept > 0 && (!(fs = calloc(kept, sizeof(*fs))) ||
+                    !(fsids = malloc((size_t)kept * sizeof(*fsids)))))) {
+    if (batch)
+      batch_release(batch);
+    free(fs);
+    free(entries);
+    free(buf);
+    return -1;
+  }
+
+  for (i = 0; i < kept; i++) {
+    job = &batch->jobs[i];
+    safe_strncpy(job->path, entries[i].mount_point, MAX_STRLEN);
+    job->btrfs = STREQ(entries[i].fstype, "btrfs");
+  }
+
+  batch_run(batch);
+
+  /* btrfs subvolumes of a filesystem already counted are dropped here, now
+     that the workers have read their UUIDs */
+  pthread_mutex_lock(&batch->lock);
+  for (i = 0, n = 0; i < kept; i++) {
+    job = &batch->jobs[i];
+
+    if (job->done && !job->ok)
+      continue;
+
+    if (job->done && job->has_fsid) {
+      for (j = 0, dup = false; j < n_fsids && !dup; j++)
+        dup = !memcmp(fsids[j], job->fsid, BTRFS_FSID_SIZE);
+
+      if (dup)
+        continue;
+      memcpy(fsids[n_fsids++], job->fsid, BTRFS_FSID_SIZE);
+    }
+
+    safe_strncpy(fs[n].mount_point, entries[i].mount_point, MAX_STRLEN);
+    safe_strncpy(fs[n].fstype, entries[i].fstype, sizeof(fs[n].fstype));
+    fs[n].remote = entries[i].remote;
+    if (job->done) {
+      fs[n].total = (unsigned long long)job->st.f_blocks * job->st.f_frsize;
+      fs[n].used = (unsigned long long)(job->st.f_blocks - job->st.f_bfree) * job->st.f_frsize;
+    } else {
+      fs[n].unresponsive = true;
+    }
+    n++;
+  }
+  pthread_mutex_unlock(&batch->lock);
+
+  batch_release(batch);
+  free(fsids);
+  free(entries);
+  free(buf);
+
+  *out = fs;
+  return n;
+}
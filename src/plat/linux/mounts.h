@@ -0,0 +1,34 @@
+/*	mounts.h
+**	-------------
+**
+**	The per-filesystem usage figures gathered from mountinfo and their
+**	reader's prototype.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_MOUNTS_H
+#define SCREENFETCH_C_MOUNTS_H
+
+#include <stdbool.h>
+
+#include "../../misc.h"
+
+/* how long statvfs() may take, for all filesystems together, before the
+   ones that have not answered are given up on as unresponsive */
+#define MOUNTS_TIMEOUT_MS 500
+
+/* how many threads may stat filesystems at once */
+#define MOUNTS_MAX_WORKERS 8
+
+struct fs_usage {
+  char mount_point[MAX_STRLEN];
+  char fstype[32];
+  unsigned long long total; /* bytes */
+  unsigned long long used;  /* bytes */
+  bool remote;
+  bool unresponsive;
+};
+
+int mounts_read(const char *mountinfo, bool with_remote, struct fs_usage **out);
+
+#endif /* SCREENFETCH_C_MOUNTS_H */
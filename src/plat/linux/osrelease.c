@@ -0,0 +1,156 @@
+/*	osrelease.c
+**	-------------
+**
+**	Parses os-release(5) with a single read and maps its ID, or failing that
+**	one of its ID_LIKE entries, to a distro through a sorted signature table,
+**	so that derivatives inherit their parent's logo and package manager.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* program includes */
+#include "../../misc.h"
+#include "../../util.h"
+#include "osrelease.h"
+
+#define OS_RELEASE_BUFSIZE (4 * KB)
+
+/* sorted by id for bsearch() */
+static const struct distro_signature signatures[] = {
+    {"angstrom", "Angstrom"},
+    {"arch", "Arch Linux"},
+    {"chakra", "Chakra"},
+    {"crunchbang", "CrunchBang"},
+    {"debian", "Debian"},
+    {"deepin", "LinuxDeepin"},
+    {"elementary", "elementary OS"},
+    {"fedora", "Fedora"},
+    {"frugalware", "Frugalware"},
+    {"funtoo", "Funtoo"},
+    {"gentoo", "Gentoo"},
+    {"kali", "Kali Linux"},
+    {"linuxmint", "LinuxMint"},
+    {"mageia", "Mageia"},
+    {"mandriva", "Mandriva"},
+    {"manjaro", "Manjaro"},
+    {"opensuse", "OpenSUSE"},
+    {"opensuse-leap", "OpenSUSE"},
+    {"opensuse-tumbleweed", "OpenSUSE"},
+    {"parabola", "ParabolaGNU/Linux-libre"},
+    {"peppermint", "Peppermint"},
+    {"rhel", "Red Hat Linux"},
+    {"sabayon", "Sabayon"},
+    {"scientific", "Scientific Linux"},
+    {"slackware", "Slackware"},
+    {"suse", "OpenSUSE"},
+    {"trisquel", "Trisquel"},
+    {"ubuntu", "Ubuntu"},
+};
+
+/*	cmp_signature
+  bsearch comparator between an id and a signature
+*/
+static int cmp_signature(const void *key, const void *sig) {
+  return strcmp(key, ((const struct distro_signature *)sig)->id);
+}
+
+/*	signature_find
+  returns the signature for id, or NULL
+*/
+static const struct distro_signature *signature_find(const char *id) {
+  return bsearch(id, signatures, sizeof(signatures) / sizeof(signatures[0]),
+                 sizeof(signatures[0]), cmp_signature);
+}
+
+/*	unquote_value
+  copies an os-release value into out (size bytes), removing the shell
+  quoting and backslash escapes the format allows
+*/
+static void unquote_value(const char *val, char *out, size_t size) {
+  char quote = 0;
+  size_t o = 0;
+
+  if (*val == '"' || *val == '\'')
+    quote = *val++;
+
+  for (; *val && o < size - 1; val++) {
+    if (quote && *val == quote)
+      break;
+
+    if (*val == '\\' && quote != '\'' && val[1])
+      val++;
+
+    out[o++] = *val;
+  }
+
+  out[o] = '\0';
+}
+
+/*	os_release_read
+  fills osr from the os-release file at path
+  returns false if the file could not be read or has no ID or NAME
+*/
+bool os_release_read(const char *path, struct os_release *osr) {
+  char buf[OS_RELEASE_BUFSIZE];
+  char *line, *next, *eq;
+
+  memset(osr, 0, sizeof(*osr));
+
+  if (read_file(path, buf, sizeof(buf)) <= 0)
+    return false;
+
+  for (line = buf; line && *line; line = next) {
+    if ((next = strchr(line, '\n')))
+      *next++ = '\0';
+
+    if (*line == '#' || !(eq = strchr(line, '=')))
+      continue;
+
+    *eq++ = '\0';
+
+    if (STREQ(line, "ID"))
+      unquote_value(eq, osr->id, sizeof(osr->id));
+    else if (STREQ(line, "ID_LIKE"))
+      unquote_value(eq, osr->id_like, sizeof(osr->id_like));
+    else if (STREQ(line, "NAME"))
+      unquote_value(eq, osr->name, sizeof(osr->name));
+    else if (STREQ(line, "PRETTY_NAME"))
+      unquote_value(eq, osr->pretty_name, sizeof(osr->pretty_name));
+    else if (STREQ(line, "VERSION_ID"))
+      unquote_value(eq, osr->version_id, sizeof(osr->version_id));
+  }
+
+  return osr->id[0] || osr->name[0];
+}
+
+/*	os_release_match
+  finds the signature for osr's ID or, setting derived, for the first
+  of its ID_LIKE entries that has one
+  returns NULL if neither is known
+*/
+const struct distro_signature *os_release_match(const struct os_release *osr, bool *derived) {
+  const struct distro_signature *sig;
+  char like[MAX_STRLEN];
+  char *id, *save = NULL;
+
+  *derived = false;
+
+  if (osr->id[0] && (sig = signature_find(osr->id)))
+    return sig;
+
+  safe_strncpy(like, osr->id_like, MAX_STRLEN);
+
+  for (id = strtok_r(like, " ", &save); id; id = strtok_r(NULL, " ", &save)) {
+    if ((sig = signature_find(id))) {
+      *derived = true;
+      return sig;
+    }
+  }
+
+  return NULL;
+}
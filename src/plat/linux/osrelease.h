@@ -0,0 +1,33 @@
+/*	osrelease.h
+**	-------------
+**
+**	The fields of os-release(5) used to identify a distro, the table
+**	mapping them to screenfetch-c's distro names, and their prototypes.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_OSRELEASE_H
+#define SCREENFETCH_C_OSRELEASE_H
+
+#include <stdbool.h>
+
+#include "../../misc.h"
+
+struct os_release {
+  char id[64];
+  char id_like[MAX_STRLEN];
+  char name[MAX_STRLEN];
+  char pretty_name[MAX_STRLEN];
+  char version_id[64];
+};
+
+/* an os-release ID and the distro name it stands for */
+struct distro_signature {
+  const char *id;
+  const char *distro;
+};
+
+bool os_release_read(const char *path, struct os_release *osr);
+const struct distro_signature *os_release_match(const struct os_release *osr, bool *derived);
+
+#endif /* SCREENFETCH_C_OSRELEASE_H */
@@ -0,0 +1,137 @@
+/*	procstat.c
+**	-------------
+**
+**	Samples the CPU time counters in /proc/stat. The file is read in one go
+**	and its "cpu" lines are parsed by hand, without stdio, so that machines
+**	with hundreds of CPUs cost no more than a single small read.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* program includes */
+#include "../../misc.h"
+#include "../../util.h"
+#include "procstat.h"
+
+/* user, nice, system, idle, iowait, irq, softirq, steal; guest time is
+   already counted in user and nice, so the guest columns are ignored */
+#define PROCSTAT_FIELDS 8
+#define PROCSTAT_IDLE 3
+#define PROCSTAT_IOWAIT 4
+
+/*	parse_ull
+  parses a decimal number at *p, advancing *p past it and any leading blanks
+*/
+static unsigned long long parse_ull(const char **p) {
+  unsigned long long n = 0;
+  const char *s = *p;
+
+  while (*s == ' ')
+    s++;
+
+  while (*s >= '0' && *s <= '9')
+    n = n * 10 + (unsigned long long)(*s++ - '0');
+
+  *p = s;
+  return n;
+}
+
+/*	parse_times
+  parses the counters following a "cpu" or "cpuN" label into t
+*/
+static void parse_times(const char *p, struct cpu_times *t) {
+  unsigned long long v, idle = 0;
+  int i;
+
+  t->total = 0;
+
+  for (i = 0; i < PROCSTAT_FIELDS && *p == ' '; i++) {
+    v = parse_ull(&p);
+    t->total += v;
+
+    if (i == PROCSTAT_IDLE || i == PROCSTAT_IOWAIT)
+      idle += v;
+  }
+
+  t->busy = t->total - idle;
+}
+
+/*	procstat_sample
+  reads the aggregate CPU times (and, if per_cpu is set, those of every
+  online CPU) from the stat file at path, normally /proc/stat
+  returns false if the file could not be read or has no "cpu" line
+*/
+bool procstat_sample(const char *path, struct cpu_sample *s, bool per_cpu) {
+  char *buf, *line, *eol;
+  const char *p;
+  unsigned int cap = 0;
+  size_t len;
+  bool found = false;
+
+  memset(s, 0, sizeof(*s));
+
+  if (!(buf = read_file_alloc(path, &len)))
+    return false;
+
+  /* the cpu lines always come first; stop at the first line that isn't one */
+  for (line = buf; line < buf + len && BEGINS_WITH(line, "cpu"); line = eol + 1) {
+    if (!(eol = memchr(line, '\n', buf + len - line)))
+      eol = buf + len;
+    *eol = '\0';
+
+    if (line[3] == ' ') {
+      parse_times(line + 3, &s->all);
+      found = true;
+
+      if (!per_cpu)
+        break;
+      continue;
+    }
+
+    if (s->n_cpus == cap) {
+      struct cpu_times *grown;
+
+      cap = cap ? cap * 2 : 64;
+      if (!(grown = realloc(s->cpus, cap * sizeof(*grown))))
+        break;
+      s->cpus = grown;
+    }
+
+    p = line + 3;
+    s->cpus[s->n_cpus].id = (unsigned int)parse_ull(&p);
+    parse_times(p, &s->cpus[s->n_cpus]);
+    s->n_cpus++;
+  }
+
+  free(buf);
+  return found;
+}
+
+/*	procstat_free
+  releases the per-CPU times held by s
+*/
+void procstat_free(struct cpu_sample *s) {
+  free(s->cpus);
+  s->cpus = NULL;
+  s->n_cpus = 0;
+}
+
+/*	procstat_usage
+  returns the percentage of time spent busy between two samples of one CPU,
+  or -1 if no time was accounted to it in between
+*/
+int procstat_usage(const struct cpu_times *before, const struct cpu_times *after) {
+  unsigned long long busy, total;
+
+  if (after->total <= before->total || after->busy < before->busy)
+    return -1;
+
+  busy = after->busy - before->busy;
+  total = after->total - before->total;
+
+  return (int)((busy * 100 + total / 2) / total);
+}
@@ -0,0 +1,29 @@
+/*	procstat.h
+**	-------------
+**
+**	CPU time samples taken from /proc/stat and their reader's prototypes.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_PROCSTAT_H
+#define SCREENFETCH_C_PROCSTAT_H
+
+#include <stdbool.h>
+
+struct cpu_times {
+  unsigned int id; /* N in "cpuN"; unused for the aggregate line */
+  unsigned long long busy;
+  unsigned long long total;
+};
+
+struct cpu_sample {
+  struct cpu_times all;
+  struct cpu_times *cpus;
+  unsigned int n_cpus;
+};
+
+bool procstat_sample(const char *path, struct cpu_sample *s, bool per_cpu);
+void procstat_free(struct cpu_sample *s);
+int procstat_usage(const struct cpu_times *before, const struct cpu_times *after);
+
+#endif /* SCREENFETCH_C_PROCSTAT_H */
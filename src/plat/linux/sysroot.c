@@ -0,0 +1,471 @@
+/*	sysroot.c
+**	-------------
+**
+**	The detectors that answer from a system's files alone (distro, packages,
+**	installed kernel and login shell), written against a root directory so
+**	that they work the same on the running system, whose root is "", and
+**	on a chroot or unpacked image, whose root is its path without a trailing
+**	slash. Links under another root are followed within it, the way its own
+**	system would follow them, rather than out into ours. They keep no state
+**	of their own and store into the calling thread's field set, so that
+**	several roots can be detected at once.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+
+/* linux-specific includes */
+#include <unistd.h>
+#include <dirent.h>
+#include <errno.h>
+
+/* program includes */
+#include "../../fields.h"
+#include "../../misc.h"
+#include "../../disp.h"
+#include "../../util.h"
+#include "../../distros.h"
+#include "../../error_flag.h"
+#include "osrelease.h"
+#include "sysroot.h"
+
+/* something that gives a distro away, and the distro it stands for */
+struct distro_marker {
+  const char *marker;
+  const char *distro;
+};
+
+/* what /etc/issue starts with */
+static const struct distro_marker issue_prefixes[] = {
+    {"Kali", "Kali Linux"}, {"Back", "Backtrack Linux"}, {"Crun", "CrunchBang"},
+    {"LMDE", "LMDE"},       {"Debi", "Debian"},          {"Rasp", "Debian"},
+};
+
+/* the distro-specific release files, and the distro each one stands for */
+static const struct distro_marker release_files[] = {
+    {"/etc/redhat-release", "Red Hat Linux"}, {"/etc/fedora-release", "Fedora"},
+    {"/etc/SuSE-release", "OpenSUSE"},        {"/etc/arch-release", "Arch Linux"},
+    {"/etc/gentoo-release", "Gentoo"},        {"/etc/angstrom-version", "Angstrom"},
+    {"/etc/manjaro-release", "Manjaro"},      {"/etc/slackware-release", "Slackware"},
+};
+
+/* as many links as the kernel follows in a path before giving up */
+#define ROOT_MAX_LINKS 40
+
+/*	sysroot_path
+  resolves path (which starts with a slash) under root into buf, which
+  holds MAX_STRLEN bytes, following every symbolic link on the way the way
+  the system under root would: absolute targets and ".." stay inside root
+  rather than escaping to ours; from the first component that does not
+  exist on, the path is kept as it is
+  returns buf, empty if the path is too long or loops
+*/
+char *sysroot_path(char *buf, const char *root, const char *path) {
+  char rest[MAX_STRLEN], link[MAX_STRLEN], next[MAX_STRLEN];
+  size_t root_len = strlen(root), len, clen;
+  const char *comp, *p;
+  int links = 0;
+  ssize_t n;
+
+  /* our own root is the kernel's, which resolves it just the same */
+  if (!*root) {
+    if (snprintf(buf, MAX_STRLEN, "%s", path) >= MAX_STRLEN)
+      buf[0] = '\0';
+    return buf;
+  }
+
+  if (root_len >= MAX_STRLEN || snprintf(rest, MAX_STRLEN, "%s", path) >= MAX_STRLEN)
+    goto fail;
+
+  memcpy(buf, root, root_len + 1);
+  len = root_len;
+
+  for (p = rest; *p;) {
+    for (; *p == '/'; p++)
+      ;
+    comp = p;
+    clen = strcspn(p, "/");
+    p += clen;
+
+    if (!clen || (clen == 1 && comp[0] == '.'))
+      continue;
+
+    if (clen == 2 && comp[0] == '.' && comp[1] == '.') {
+      while (len > root_len && buf[len - 1] != '/')
+        len--;
+      if (len > root_len)
+        len--;
+      buf[len] = '\0';
+      continue;
+    }
+
+    if (len + 1 + clen >= MAX_STRLEN)
+      goto fail;
+    buf[len++] = '/';
+    memcpy(buf + len, comp, clen);
+    buf[len += clen] = '\0';
+
+    if ((n = readlink(buf, link, sizeof(link) - 1)) < 0) {
+      if (errno == EINVAL)
+        continue;
+
+      /* nothing more to resolve: whatever opens it will find it missing */
+      if (snprintf(buf + len, MAX_STRLEN - len, "%s", p) >= (int)(MAX_STRLEN - len))
+        goto fail;
+      return buf;
+    }
+
+    if (++links > ROOT_MAX_LINKS || n >= (ssize_t)sizeof(link) - 1)
+      goto fail;
+    link[n] = '\0';
+
+    /* the link takes its component's place, and an absolute one starts over
+       from root */
+    len = link[0] == '/' ? root_len : len - clen - 1;
+    buf[len] = '\0';
+
+    if (snprintf(next, MAX_STRLEN, "%s/%s", link, p) >= MAX_STRLEN)
+      goto fail;
+    memcpy(rest, next, strlen(next) + 1);
+    p = rest;
+  }
+
+  return buf;
+
+fail:
+  buf[0] = '\0';
+  return buf;
+}
+
+/*	root_exists
+  returns true if path exists under root
+*/
+static bool root_exists(const char *root, const char *path) {
+  char buf[MAX_STRLEN];
+
+  return FILE_EXISTS(sysroot_path(buf, root, path));
+}
+
+/*	distro_legacy
+  identifies the distro of a system too old to have an os-release file,
+  through /etc/issue and the distro-specific release files
+*/
+static void distro_legacy(const char *root) {
+  char path[MAX_STRLEN], buf[MAX_STRLEN];
+  const char *id;
+  size_t i;
+
+  /* Bad solution, as /etc/issue contains junk on some distros */
+  if (read_file(sysroot_path(path, root, "/etc/issue"), buf, sizeof(buf)) > 0) {
+    for (i = 0; i < sizeof(issue_prefixes) / sizeof(issue_prefixes[0]); i++) {
+      if (BEGINS_WITH(buf, issue_prefixes[i].marker)) {
+        field_set_str(FIELD_OS, issue_prefixes[i].distro);
+        return;
+      }
+    }
+  }
+
+  for (i = 0; i < sizeof(release_files) / sizeof(release_files[0]); i++) {
+    if (root_exists(root, release_files[i].marker)) {
+      field_set_str(FIELD_OS, release_files[i].distro);
+      return;
+    }
+  }
+
+  if (read_file(sysroot_path(path, root, "/etc/lsb-release"), buf, sizeof(buf)) > 0 &&
+      (id = strstr(buf, "DISTRIB_ID="))) {
+    id += strlen("DISTRIB_ID=");
+    field_printf(FIELD_OS, "%.*s", (int)strcspn(id, " \n"), id);
+    return;
+  }
+
+  field_set_str(FIELD_OS, "Linux");
+
+  if (error)
+    ERR_REPORT("Failed to detect a Linux distro.");
+}
+
+/*	sysroot_distro
+  detects the distribution under root from os-release(5), falling back on
+  older distro-specific files; derivatives unknown to screenfetch-c keep
+  their own name but borrow their parent's logo and package manager
+*/
+void sysroot_distro(const char *root) {
+  char path[MAX_STRLEN], name[MAX_STRLEN];
+  const struct distro_signature *sig;
+  struct os_release osr;
+  bool derived;
+
+  if (root_exists(root, "/system/bin/getprop")) {
+    field_set_str(FIELD_OS, "Android");
+    return;
+  }
+
+  if (!os_release_read(sysroot_path(path, root, "/etc/os-release"), &osr) &&
+      !os_release_read(sysroot_path(path, root, "/usr/lib/os-release"), &osr)) {
+    distro_legacy(root);
+    return;
+  }
+
+  sig = os_release_match(&osr, &derived);
+  field_set_str(FIELD_OS_BASE, sig ? sig->distro : "Linux");
+
+  /* PRETTY_NAME already carries the version; everything else gets VERSION_ID */
+  if (sig && !derived)
+    snprintf(name, MAX_STRLEN, "%s %s", sig->distro, osr.version_id);
+  else if (osr.name[0]) {
+    /* a name too long to take its version goes without it */
+    if (snprintf(name, MAX_STRLEN, "%s %s", osr.name, osr.version_id) >= MAX_STRLEN)
+      safe_strncpy(name, osr.name, MAX_STRLEN);
+  } else
+    safe_strncpy(name, osr.pretty_name[0] ? osr.pretty_name : osr.id, MAX_STRLEN);
+
+  /* drop the separator if there was no VERSION_ID */
+  if (name[0] && name[strlen(name) - 1] == ' ')
+    name[strlen(name) - 1] = '\0';
+
+  field_set_str(FIELD_OS, name);
+}
+
+/*	shell_quote
+  single-quotes s for the shell into buf
+  returns false if it does not fit
+*/
+static bool shell_quote(char *buf, size_t size, const char *s) {
+  size_t len = 0;
+
+  buf[len++] = '\'';
+  for (; *s; s++) {
+    if (len + 5 >= size)
+      return false;
+    if (*s == '\'') {
+      memcpy(buf + len, "'\\''", 4);
+      len += 4;
+    } else {
+      buf[len++] = *s;
+    }
+  }
+  buf[len++] = '\'';
+  buf[len] = '\0';
+
+  return true;
+}
+
+/*	count_entries
+  counts the entries (hidden ones aside) of the directory at path under
+  root whose names end in suffix or, with a depth of 2, the entries of each
+  of its subdirectories
+  returns the count, or -1 if the directory cannot be read
+*/
+static int count_entries(const char *root, const char *path, const char *suffix, int depth) {
+  char buf[MAX_STRLEN], sub[MAX_STRLEN];
+  size_t len, suffix_len = strlen(suffix);
+  struct dirent *entry;
+  int n = 0, m;
+  DIR *dir;
+
+  if (!(dir = opendir(sysroot_path(buf, root, path))))
+    return -1;
+
+  while ((entry = readdir(dir))) {
+    if (entry->d_name[0] == '.')
+      continue;
+
+    if (depth > 1) {
+      if (snprintf(sub, MAX_STRLEN, "%s/%s", path, entry->d_name) < MAX_STRLEN &&
+          (m = count_entries(root, sub, suffix, depth - 1)) > 0)
+        n += m;
+    } else if ((len = strlen(entry->d_name)) >= suffix_len &&
+               STREQ(entry->d_name + len - suffix_len, suffix)) {
+      n++;
+    }
+  }
+
+  closedir(dir);
+  return n;
+}
+
+/*	sysroot_pkgs
+  detects the number of packages installed under root, the way the
+  distro's package manager keeps them; needs the distro detected first
+*/
+void sysroot_pkgs(const char *root) {
+  const char *db = NULL, *suffix = "", *command = NULL;
+  char buf[MAX_STRLEN], quoted[MAX_STRLEN];
+  const struct distro *d;
+  FILE *pkgs_file;
+  int packages = 0, depth = 1;
+
+  d = distro_find(field_str(field_isset(FIELD_OS_BASE) ? FIELD_OS_BASE : FIELD_OS));
+
+  switch (d ? d->pkgs : PKG_NONE) {
+  case PKG_PACMAN:
+    db = "/var/lib/pacman/local";
+    break;
+  case PKG_PACMAN_G2:
+    command = "pacman-g2 -Q 2> /dev/null | wc -l";
+    break;
+  case PKG_DPKG:
+    db = "/var/lib/dpkg/info";
+    suffix = ".list";
+    break;
+  case PKG_SLACKWARE:
+    db = "/var/log/packages";
+    break;
+  case PKG_PORTAGE:
+    /* category/package */
+    db = "/var/db/pkg";
+    depth = 2;
+    break;
+  case PKG_RPM:
+    /* RPM uses Berkeley DBs internally, so this won't change soon */
+    command = "rpm -qa 2> /dev/null | wc -l";
+    break;
+  case PKG_OPKG:
+    command = "opkg list-installed 2> /dev/null | wc -l";
+    break;
+  case PKG_UNKNOWN: /* if linux disto detection failed */
+    if (error)
+      ERR_REPORT("Packages cannot be detected on an unknown "
+                 "Linux distro.");
+    return;
+  case PKG_NONE:
+    break;
+  }
+
+  if (db) {
+    /* the database is read through root, so that its links stay inside it */
+    if ((packages = count_entries(root, db, suffix, depth)) < 0) {
+      packages = 0;
+      if (error)
+        ERR_REPORT("Failure while reading the package database.");
+    }
+  } else if (command && *root) {
+    /* only rpm can be pointed at another root's database */
+    if (d->pkgs != PKG_RPM || !shell_quote(quoted, sizeof(quoted), root) ||
+        snprintf(buf, sizeof(buf), "rpm --root %s -qa 2> /dev/null | wc -l", quoted) >=
+            (int)sizeof(buf)) {
+      if (error)
+        ERR_REPORT("Packages cannot be counted under another root on this distro.");
+      return;
+    }
+
+    command = buf;
+  }
+
+  if (command && (pkgs_file = popen(command, "r"))) {
+    fscanf(pkgs_file, "%d", &packages);
+    pclose(pkgs_file);
+  }
+
+  field_set_int(FIELD_PKGS, packages);
+}
+
+/*	version_cmp
+  compares two kernel versions, taking runs of digits as numbers
+  returns less than, equal to or more than 0, like strcmp()
+*/
+static int version_cmp(const char *a, const char *b) {
+  const char *na, *nb;
+  size_t la, lb;
+  int cmp;
+
+  while (*a && *b) {
+    if (isdigit((unsigned char)*a) && isdigit((unsigned char)*b)) {
+      for (; *a == '0'; a++)
+        ;
+      for (; *b == '0'; b++)
+        ;
+      for (na = a; isdigit((unsigned char)*a); a++)
+        ;
+      for (nb = b; isdigit((unsigned char)*b); b++)
+        ;
+
+      la = a - na;
+      lb = b - nb;
+      if (la != lb)
+        return la < lb ? -1 : 1;
+      if ((cmp = strncmp(na, nb, la)))
+        return cmp;
+    } else if (*a != *b) {
+      return (unsigned char)*a - (unsigned char)*b;
+    } else {
+      a++;
+      b++;
+    }
+  }
+
+  return (unsigned char)*a - (unsigned char)*b;
+}
+
+/*	sysroot_kernel
+  detects the newest kernel installed under root from its modules
+  directory, for systems that are not running
+*/
+void sysroot_kernel(const char *root) {
+  static const char *const dirs[] = {"/lib/modules", "/usr/lib/modules"};
+  char path[MAX_STRLEN], newest[MAX_STRLEN] = "";
+  struct dirent *entry;
+  size_t i;
+  DIR *dir;
+
+  for (i = 0; i < sizeof(dirs) / sizeof(dirs[0]); i++) {
+    if (!(dir = opendir(sysroot_path(path, root, dirs[i]))))
+      continue;
+
+    while ((entry = readdir(dir))) {
+      if (entry->d_name[0] != '.' && version_cmp(entry->d_name, newest) > 0)
+        safe_strncpy(newest, entry->d_name, MAX_STRLEN);
+    }
+
+    closedir(dir);
+  }
+
+  if (newest[0])
+    field_printf(FIELD_KERNEL, "Linux %s", newest);
+  else if (error)
+    ERR_REPORT("Could not find an installed kernel.");
+}
+
+/*	sysroot_shell
+  detects root's login shell from the passwd file under root, for systems
+  that are not running; the shells cannot be run for their versions
+*/
+void sysroot_shell(const char *root) {
+  char path[MAX_STRLEN], line[MAX_STRLEN];
+  char *fields[7], *p, *shell, *base;
+  FILE *passwd;
+  int i;
+
+  if (!(passwd = fopen(sysroot_path(path, root, "/etc/passwd"), "r"))) {
+    if (error)
+      ERR_REPORT("Could not open the passwd file.");
+    return;
+  }
+
+  while (fgets(line, sizeof(line), passwd)) {
+    line[strcspn(line, "\n")] = '\0';
+
+    /* name:password:uid:gid:gecos:home:shell */
+    for (p = line, i = 0; i < 7 && p; i++) {
+      fields[i] = p;
+      if ((p = strchr(p, ':')))
+        *p++ = '\0';
+    }
+
+    if (i < 7 || !STREQ(fields[2], "0") || !*fields[6])
+      continue;
+
+    shell = fields[6];
+    base = strrchr(shell, '/') ? strrchr(shell, '/') + 1 : shell;
+    field_set_str(FIELD_SHELL, STREQ(shell, "/bin/sh") ? "POSIX sh" : base);
+    break;
+  }
+
+  fclose(passwd);
+}
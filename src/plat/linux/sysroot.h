@@ -0,0 +1,18 @@
+/*	sysroot.h
+**	-------------
+**
+**	Function prototypes for sysroot.c, the detectors that only need a
+**	system's files and so can look at any root directory.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_SYSROOT_H
+#define SCREENFETCH_C_SYSROOT_H
+
+char *sysroot_path(char *buf, const char *root, const char *path);
+void sysroot_distro(const char *root);
+void sysroot_pkgs(const char *root);
+void sysroot_kernel(const char *root);
+void sysroot_shell(const char *root);
+
+#endif /* SCREENFETCH_C_SYSROOT_H */
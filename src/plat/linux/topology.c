@@ -0,0 +1,284 @@
+/*	topology.c
+**	-------------
+**
+**	Reads the shape of the machine (sockets, cores, SMT, caches and hybrid
+**	core types) from /sys/devices/system/cpu. Every file is opened relative to
+**	one cached directory fd, and each core, package and cache instance is only
+**	visited once, through its first CPU, so large hosts cost a few hundred
+**	small reads.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* linux-specific includes */
+#include <fcntl.h>
+#include <unistd.h>
+
+/* program includes */
+#include "../../misc.h"
+#include "../../util.h"
+#include "topology.h"
+
+#define MAX_CPUS 8192
+#define CPUSET_WORDS (MAX_CPUS / 64)
+
+typedef uint64_t cpuset[CPUSET_WORDS];
+
+#define CPU_IN(set, cpu) (((set)[(cpu) / 64] >> ((cpu) % 64)) & 1)
+#define CPU_CLEAR(set, cpu) ((set)[(cpu) / 64] &= ~((uint64_t)1 << ((cpu) % 64)))
+
+/*	cpuset_parse
+  parses a kernel cpulist ("0-3,8,10-11") into set
+  returns false if the list is empty or malformed
+*/
+static bool cpuset_parse(const char *list, cpuset set) {
+  unsigned long lo, hi, cpu;
+  char *end;
+
+  memset(set, 0, sizeof(cpuset));
+
+  while (*list && *list != '\n') {
+    lo = strtoul(list, &end, 10);
+    if (end == list)
+      return false;
+
+    hi = lo;
+    if (*end == '-') {
+      list = end + 1;
+      hi = strtoul(list, &end, 10);
+      if (end == list)
+        return false;
+    }
+
+    for (cpu = lo; cpu <= hi && cpu < MAX_CPUS; cpu++)
+      set[cpu / 64] |= (uint64_t)1 << (cpu % 64);
+
+    list = *end == ',' ? end + 1 : end;
+  }
+
+  return true;
+}
+
+/*	cpuset_weight
+  returns the number of CPUs in set
+*/
+static unsigned int cpuset_weight(const cpuset set) {
+  unsigned int i, n = 0;
+  uint64_t w;
+
+  for (i = 0; i < CPUSET_WORDS; i++) {
+    for (w = set[i]; w; w &= w - 1)
+      n++;
+  }
+
+  return n;
+}
+
+/*	cpuset_or
+  adds every CPU in src to dst
+*/
+static void cpuset_or(cpuset dst, const cpuset src) {
+  unsigned int i;
+
+  for (i = 0; i < CPUSET_WORDS; i++)
+    dst[i] |= src[i];
+}
+
+/*	cpuset_andnot
+  removes every CPU in src from dst
+*/
+static void cpuset_andnot(cpuset dst, const cpuset src) {
+  unsigned int i;
+
+  for (i = 0; i < CPUSET_WORDS; i++)
+    dst[i] &= ~src[i];
+}
+
+/*	cpuset_subset
+  returns true if every CPU in a is also in b
+*/
+static bool cpuset_subset(const cpuset a, const cpuset b) {
+  unsigned int i;
+
+  for (i = 0; i < CPUSET_WORDS; i++) {
+    if (a[i] & ~b[i])
+      return false;
+  }
+
+  return true;
+}
+
+/*	cpuset_first
+  returns the lowest CPU in set, or MAX_CPUS if it is empty
+*/
+static unsigned int cpuset_first(const cpuset set) {
+  unsigned int cpu;
+
+  for (cpu = 0; cpu < MAX_CPUS && !CPU_IN(set, cpu); cpu++)
+    ;
+
+  return cpu;
+}
+
+/*	read_cpuset_at
+  reads a cpulist file below dirfd into set
+*/
+static bool read_cpuset_at(int dirfd, const char *path, cpuset set) {
+  char buf[4 * KB];
+
+  return read_file_at(dirfd, path, buf, sizeof(buf)) > 0 && cpuset_parse(buf, set);
+}
+
+/*	read_shared_at
+  reads the CPUs sharing cpu's cache number index into set, or just cpu if
+  the list cannot be read
+*/
+static void read_shared_at(int dirfd, unsigned int cpu, unsigned int index, cpuset set) {
+  char path[MAX_STRLEN];
+
+  snprintf(path, MAX_STRLEN, "cpu%u/cache/index%u/shared_cpu_list", cpu, index);
+  if (!read_cpuset_at(dirfd, path, set)) {
+    memset(set, 0, sizeof(cpuset));
+    set[cpu / 64] |= (uint64_t)1 << (cpu % 64);
+  }
+}
+
+/*	read_caches
+  reads the cache hierarchy (cpuN/cache/index*) of the first of cpus, the
+  online CPUs of one core type, into t, and counts each cache's instances
+  from the distinct CPU sets sharing it; with skip_shared, caches shared
+  with CPUs of another type have been read with that type and are skipped
+*/
+static void read_caches(int dirfd, const cpuset cpus, bool skip_shared, struct topology *t) {
+  char path[MAX_STRLEN];
+  char buf[64];
+  cpuset shared, covered;
+  struct cpu_cache *c;
+  unsigned int cpu = cpuset_first(cpus), other, i;
+  int len;
+
+  if (cpu == MAX_CPUS)
+    return;
+
+  for (i = 0; t->n_caches < TOPOLOGY_MAX_CACHES; i++) {
+    c = &t->caches[t->n_caches];
+
+    len = snprintf(path, MAX_STRLEN, "cpu%u/cache/index%u/", cpu, i);
+
+    safe_strncpy(path + len, "level", MAX_STRLEN - len);
+    if (read_file_at(dirfd, path, buf, sizeof(buf)) <= 0)
+      break;
+    c->level = strtoul(buf, NULL, 10);
+
+    safe_strncpy(path + len, "type", MAX_STRLEN - len);
+    if (read_file_at(dirfd, path, buf, sizeof(buf)) <= 0)
+      continue;
+    c->type = buf[0] == 'D' ? 'd' : buf[0] == 'I' ? 'i' : 'u';
+
+    safe_strncpy(path + len, "size", MAX_STRLEN - len);
+    if (read_file_at(dirfd, path, buf, sizeof(buf)) <= 0 || !(c->size_kb = strtoul(buf, NULL, 10)))
+      continue;
+
+    read_shared_at(dirfd, cpu, i, shared);
+    if (skip_shared && !cpuset_subset(shared, cpus))
+      continue;
+    c->shared_cpus = cpuset_weight(shared);
+
+    /* one read per further instance: the CPUs sharing it are skipped afterwards */
+    memcpy(covered, cpus, sizeof(cpuset));
+    cpuset_andnot(covered, shared);
+    for (c->instances = 1; (other = cpuset_first(covered)) < MAX_CPUS; c->instances++) {
+      read_shared_at(dirfd, other, i, shared);
+      CPU_CLEAR(covered, other);
+      cpuset_andnot(covered, shared);
+    }
+
+    t->n_caches++;
+  }
+}
+
+/*	topology_read
+  fills t from the sysfs CPU directory sysfs_cpu (normally /sys/devices/system/cpu)
+  returns false if the online CPU list could not be read
+*/
+bool topology_read(const char *sysfs_cpu, struct topology *t) {
+  char path[MAX_STRLEN];
+  cpuset online, core_seen, pkg_seen, siblings, pcore, ecore;
+  unsigned int cpu, weight;
+  bool hybrid;
+  int dirfd;
+
+  memset(t, 0, sizeof(*t));
+
+  if ((dirfd = open(sysfs_cpu, O_RDONLY | O_DIRECTORY | O_CLOEXEC)) < 0)
+    return false;
+
+  if (!read_cpuset_at(dirfd, "online", online)) {
+    close(dirfd);
+    return false;
+  }
+
+  /* hybrid (P-core/E-core) parts expose one perf PMU per core type */
+  hybrid = read_cpuset_at(dirfd, "../../cpu_core/cpus", pcore);
+
+  memset(core_seen, 0, sizeof(cpuset));
+  memset(pkg_seen, 0, sizeof(cpuset));
+  t->threads = cpuset_weight(online);
+  t->smt = 1;
+
+  for (cpu = 0; cpu < MAX_CPUS; cpu++) {
+    if (!CPU_IN(online, cpu) || CPU_IN(core_seen, cpu))
+      continue;
+
+    /* one read per core: its hardware threads are all skipped afterwards */
+    snprintf(path, MAX_STRLEN, "cpu%u/topology/thread_siblings_list", cpu);
+    if (!read_cpuset_at(dirfd, path, siblings)) {
+      memset(siblings, 0, sizeof(cpuset));
+      siblings[cpu / 64] |= (uint64_t)1 << (cpu % 64);
+    }
+
+    cpuset_or(core_seen, siblings);
+    t->cores++;
+
+    if ((weight = cpuset_weight(siblings)) > t->smt)
+      t->smt = weight;
+
+    if (hybrid) {
+      if (CPU_IN(pcore, cpu))
+        t->pcores++;
+      else
+        t->ecores++;
+    }
+
+    /* likewise, one read per package */
+    if (!CPU_IN(pkg_seen, cpu)) {
+      snprintf(path, MAX_STRLEN, "cpu%u/topology/core_siblings_list", cpu);
+      if (read_cpuset_at(dirfd, path, siblings))
+        cpuset_or(pkg_seen, siblings);
+      else
+        cpuset_or(pkg_seen, online);
+      t->sockets++;
+    }
+  }
+
+  /* the core types of hybrid parts each have caches of their own */
+  if (hybrid) {
+    memcpy(ecore, online, sizeof(cpuset));
+    cpuset_andnot(ecore, pcore);
+    memcpy(pcore, online, sizeof(cpuset));
+    cpuset_andnot(pcore, ecore);
+    read_caches(dirfd, pcore, false, t);
+    read_caches(dirfd, ecore, true, t);
+  } else {
+    read_caches(dirfd, online, false, t);
+  }
+
+  close(dirfd);
+  return true;
+}
@@ -0,0 +1,36 @@
+/*	topology.h
+**	-------------
+**
+**	The CPU topology summary read from sysfs and its reader's prototype.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_TOPOLOGY_H
+#define SCREENFETCH_C_TOPOLOGY_H
+
+#include <stdbool.h>
+
+#define TOPOLOGY_MAX_CACHES 8
+
+struct cpu_cache {
+  unsigned int level;
+  char type; /* 'd'ata, 'i'nstruction or 'u'nified */
+  unsigned long size_kb;
+  unsigned int shared_cpus; /* CPUs sharing one instance of the cache */
+  unsigned int instances;   /* instances among the CPUs of its core type */
+};
+
+struct topology {
+  unsigned int sockets;
+  unsigned int cores;
+  unsigned int threads;
+  unsigned int smt;
+  unsigned int pcores; /* hybrid parts only: cores on the cpu_core PMU */
+  unsigned int ecores; /* hybrid parts only: cores on the cpu_atom PMU */
+  struct cpu_cache caches[TOPOLOGY_MAX_CACHES];
+  unsigned int n_caches;
+};
+
+bool topology_read(const char *sysfs_cpu, struct topology *t);
+
+#endif /* SCREENFETCH_C_TOPOLOGY_H */
@@ -0,0 +1,217 @@
+/*	x11.c
+**	-------------
+**
+**	The X display is opened once, by whichever detection function needs it
+**	first, and shared by the rest and by the screenshot. Screenshots are
+**	read straight from the server, through a MIT-SHM segment when the
+**	server is local, and streamed into a PNG a row at a time.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* linux-specific includes */
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+
+/* program includes */
+#include "../../disp.h"
+#include "../../png.h"
+#include "../../error_flag.h"
+#include "x11.h"
+
+static Display *display;
+static bool display_tried;
+
+static void x11_close(void) {
+  XCloseDisplay(display);
+}
+
+/*	x11_display
+  returns the X display, opening it on the first call, or NULL if there is
+  no X server
+*/
+Display *x11_display(void) {
+  if (!display_tried) {
+    display_tried = true;
+    if ((display = XOpenDisplay(NULL)))
+      atexit(x11_close);
+  }
+
+  return display;
+}
+
+static bool shm_failed;
+
+static int shm_error(Display *disp, XErrorEvent *event) {
+  (void)disp;
+  (void)event;
+  shm_failed = true;
+  return 0;
+}
+
+/*	shm_capture
+  reads the root window into a shared memory image, which saves the server
+  from sending every pixel over the socket
+  returns the image, or NULL if the server cannot share memory with us
+  (it is remote, or has no MIT-SHM)
+*/
+static XImage *shm_capture(Display *disp, const XWindowAttributes *attr, XShmSegmentInfo *shm) {
+  int (*handler)(Display *, XErrorEvent *);
+  XImage *img;
+
+  if (!XShmQueryExtension(disp))
+    return NULL;
+
+  if (!(img = XShmCreateImage(disp, attr->visual, attr->depth, ZPixmap, NULL, shm, attr->width,
+                              attr->height)))
+    return NULL;
+
+  shm->shmid = shmget(IPC_PRIVATE, (size_t)img->bytes_per_line * img->height, IPC_CREAT | 0600);
+  if (shm->shmid < 0) {
+    XDestroyImage(img);
+    return NULL;
+  }
+
+  shm->shmaddr = img->data = shmat(shm->shmid, NULL, 0);
+  shm->readOnly = False;
+
+  /* a failed attach is reported asynchronously, so catch it around a sync */
+  shm_failed = shm->shmaddr == (char *)-1;
+  handler = XSetErrorHandler(shm_error);
+  if (!shm_failed && XShmAttach(disp, shm)) {
+    XSync(disp, False);
+    if (!shm_failed && !XShmGetImage(disp, attr->root, img, 0, 0, AllPlanes))
+      shm_failed = true;
+    XShmDetach(disp, shm);
+    XSync(disp, False);
+  } else {
+    shm_failed = true;
+  }
+  XSetErrorHandler(handler);
+
+  /* the segment goes away once we detach from it */
+  shmctl(shm->shmid, IPC_RMID, NULL);
+
+  if (shm_failed) {
+    if (shm->shmaddr != (char *)-1)
+      shmdt(shm->shmaddr);
+    shm->shmaddr = NULL;
+    img->data = NULL;
+    XDestroyImage(img);
+    return NULL;
+  }
+
+  return img;
+}
+
+/* where a color channel sits in a pixel */
+struct channel {
+  unsigned int shift;
+  unsigned long max;
+};
+
+static void channel_init(struct channel *ch, unsigned long mask) {
+  for (ch->shift = 0; mask && !(mask & 1); mask >>= 1)
+    ch->shift++;
+  ch->max = mask;
+}
+
+/*	image_row
+  converts row y of img into 8-bit RGB
+*/
+static void image_row(XImage *img, int y, const struct channel *ch, unsigned char *rgb) {
+  static const uint16_t one = 1;
+  const uint32_t *pixels = (const uint32_t *)(img->data + (size_t)y * img->bytes_per_line);
+  int host_order = *(const unsigned char *)&one ? LSBFirst : MSBFirst;
+  bool direct = img->bits_per_pixel == 32 && img->byte_order == host_order;
+  unsigned long pixel, v;
+  int x, c;
+
+  for (x = 0; x < img->width; x++) {
+    pixel = direct ? pixels[x] : XGetPixel(img, x, y);
+
+    for (c = 0; c < 3; c++) {
+      v = (pixel >> ch[c].shift) & ch[c].max;
+      *rgb++ = ch[c].max == 255 ? v : v * 255 / ch[c].max;
+    }
+  }
+}
+
+/*	x11_screenshot
+  saves the whole X screen to path as a PNG compressed at the given level
+  returns false (after reporting why) if the screenshot could not be taken
+*/
+bool x11_screenshot(const char *path, int level) {
+  Display *disp = x11_display();
+  XWindowAttributes attr;
+  XShmSegmentInfo shm;
+  struct channel ch[3];
+  unsigned char *rgb = NULL;
+  struct png png;
+  XImage *img;
+  FILE *file;
+  bool ok;
+  int y;
+
+  if (!disp) {
+    if (error)
+      ERR_REPORT("Could not open an X display (screenshot).");
+    return false;
+  }
+
+  XGetWindowAttributes(disp, DefaultRootWindow(disp), &attr);
+
+  if (attr.visual->class != TrueColor && attr.visual->class != DirectColor) {
+    if (error)
+      ERR_REPORT("Screenshots need a TrueColor display.");
+    return false;
+  }
+
+  shm.shmaddr = NULL;
+  if (!(img = shm_capture(disp, &attr, &shm)) &&
+      !(img = XGetImage(disp, attr.root, 0, 0, attr.width, attr.height, AllPlanes, ZPixmap))) {
+    if (error)
+      ERR_REPORT("Could not read the screen from the X server.");
+    return false;
+  }
+
+  channel_init(&ch[0], img->red_mask);
+  channel_init(&ch[1], img->green_mask);
+  channel_init(&ch[2], img->blue_mask);
+
+  if (!(file = fopen(path, "wb"))) {
+    if (error)
+      ERR_REPORT("Could not create the screenshot file.");
+    ok = false;
+  } else {
+    if ((ok = (rgb = malloc((size_t)img->width * 3)) &&
+              png_begin(&png, file, img->width, img->height, level))) {
+      for (y = 0; ok && y < img->height; y++) {
+        image_row(img, y, ch, rgb);
+        ok = png_write_row(&png, rgb);
+      }
+      ok = png_end(&png) && ok;
+    }
+    ok = !fclose(file) && ok;
+
+    if (!ok && error)
+      ERR_REPORT("Could not write the screenshot.");
+  }
+
+  free(rgb);
+  if (shm.shmaddr) {
+    shmdt(shm.shmaddr);
+    img->data = NULL;
+  }
+  XDestroyImage(img);
+
+  return ok;
+}
@@ -0,0 +1,18 @@
+/*	x11.h
+**	-------------
+**
+**	The X display shared by the detection functions, and the screenshot
+**	taken through it.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_X11_H
+#define SCREENFETCH_C_X11_H
+
+#include <stdbool.h>
+#include <X11/Xlib.h>
+
+Display *x11_display(void);
+bool x11_screenshot(const char *path, int level);
+
+#endif /* SCREENFETCH_C_X11_H */
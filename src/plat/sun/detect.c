@@ -25,7 +25,7 @@
 #include <X11/Xatom.h>
 
 /* program includes */
-#include "../../arrays.h"
+#include "../../fields.h"
 #include "../../colors.h"
 #include "../../misc.h"
 #include "../../disp.h"
@@ -39,13 +39,13 @@ void detect_distro(void) {
   struct utsname distro_info;
 
   uname(&distro_info);
-  snprintf(distro_str, MAX_STRLEN, "%s", distro_info.sysname);
+  field_set_str(FIELD_OS, distro_info.sysname);
 
   return;
 }
 
 /*	detect_host
-  detects the computer's hostname and active user and formats them
+  detects the computer's hostname and active user
 */
 void detect_host(void) {
   char *given_user = "Unknown";
@@ -56,8 +56,8 @@ void detect_host(void) {
   uname(&host_info);
   safe_strncpy(given_host, host_info.nodename, MAX_STRLEN);
 
-  snprintf(host_str, MAX_STRLEN, "%s%s%s%s@%s%s%s%s", host_color, given_user, TNRM, TWHT, TNRM,
-           host_color, given_host, TNRM);
+  field_set_str(FIELD_USER, given_user);
+  field_set_str(FIELD_HOSTNAME, given_host);
 
   return;
 }
@@ -69,7 +69,7 @@ void detect_kernel(void) {
   struct utsname kern_info;
 
   uname(&kern_info);
-  snprintf(kernel_str, MAX_STRLEN, "%s", kern_info.release);
+  field_set_str(FIELD_KERNEL, kern_info.release);
 
   return;
 }
@@ -79,10 +79,6 @@ void detect_kernel(void) {
 */
 void detect_uptime(void) {
   long uptime = 0, currtime = 0, boottime = 0;
-  unsigned int secs = 0;
-  unsigned int mins = 0;
-  unsigned int hrs = 0;
-  unsigned int days = 0;
   struct utmpx *ent;
 
   currtime = time(NULL);
@@ -95,12 +91,7 @@ void detect_uptime(void) {
 
   uptime = currtime - boottime;
 
-  split_uptime(uptime, &secs, &mins, &hrs, &days);
-
-  if (days > 0)
-    snprintf(uptime_str, MAX_STRLEN, "%dd %dh %dm %ds", days, hrs, mins, secs);
-  else
-    snprintf(uptime_str, MAX_STRLEN, "%dh %dm %ds", hrs, mins, secs);
+  field_set_int(FIELD_UPTIME, uptime);
 
   return;
 }
@@ -116,7 +107,7 @@ void detect_pkgs(void) {
   fscanf(pkgs_file, "%d", &packages);
   pclose(pkgs_file);
 
-  snprintf(pkgs_str, MAX_STRLEN, "%d", packages);
+  field_set_int(FIELD_PKGS, packages);
 
   return;
 }
@@ -128,12 +119,41 @@ void detect_cpu(void) {
   FILE *cpu_file;
 
   cpu_file = popen("psrinfo -pv | tail -1 | tr -d '\\t\\n'", "r");
-  fgets(cpu_str, MAX_STRLEN, cpu_file);
+  field_read_line(FIELD_CPU_MODEL, cpu_file);
   pclose(cpu_file);
 
   return;
 }
 
+/*	detect_topology
+  detects the computer's CPU topology (sockets, cores, threads and caches)
+  --
+  CAVEAT: this is not implemented on Solaris yet, so the topology is left as 'Unknown'
+  --
+*/
+void detect_topology(void) {
+  return;
+}
+
+/*	detect_cpu_usage_begin
+  takes the first CPU time sample for detect_cpu_usage
+*/
+void detect_cpu_usage_begin(bool per_core) {
+  (void)per_core;
+  return;
+}
+
+/*	detect_cpu_usage
+  detects the CPU utilisation over a short sampling window
+  --
+  CAVEAT: this is not implemented on Solaris yet, so the usage is left as 'Unknown'
+  --
+*/
+void detect_cpu_usage(unsigned int interval_ms) {
+  (void)interval_ms;
+  return;
+}
+
 /*	detect_gpu
   detects the computer's GPU brand/name-string
 */
@@ -141,7 +161,7 @@ void detect_gpu(void) {
   FILE *gpu_file;
 
   gpu_file = popen("detectgpu 2>/dev/null", "r");
-  fgets(gpu_str, MAX_STRLEN, gpu_file);
+  field_read_line(FIELD_GPU, gpu_file);
   pclose(gpu_file);
 
   return;
@@ -149,16 +169,17 @@ void detect_gpu(void) {
 
 /*	detect_disk
   detects the computer's total disk capacity and usage
+  argument bool per_fs: unused, the per-filesystem breakdown is Linux-only
 */
-void detect_disk(void) {
+void detect_disk(bool per_fs) {
   struct statvfs disk_info;
-  unsigned long disk_total = 0, disk_used = 0, disk_percentage = 0;
+
+  (void)per_fs;
 
   if (!(statvfs(getenv("HOME"), &disk_info))) {
-    disk_total = ((disk_info.f_blocks * disk_info.f_bsize) / GB);
-    disk_used = (((disk_info.f_blocks - disk_info.f_bfree) * disk_info.f_bsize) / GB);
-    disk_percentage = (((float)disk_used / disk_total) * 100);
-    snprintf(disk_str, MAX_STRLEN, "%ldG / %ldG (%ld%%)", disk_used, disk_total, disk_percentage);
+    field_set_int(FIELD_DISK_TOTAL, (long long)disk_info.f_blocks * disk_info.f_bsize);
+    field_set_int(FIELD_DISK_USED,
+                  (long long)(disk_info.f_blocks - disk_info.f_bfree) * disk_info.f_bsize);
   } else if (error) {
     ERR_REPORT("Could not stat $HOME for filesystem statistics.");
   }
@@ -170,14 +191,9 @@ void detect_disk(void) {
   detects the computer's total and used RAM
 */
 void detect_mem(void) {
-  long long total_mem = 0;
-
-  total_mem = (long long)sysconf(_SC_PHYS_PAGES) * (long long)sysconf(_SC_PAGE_SIZE);
-  total_mem /= MB;
-
   /* sar -r 1 to get free pages? */
-
-  snprintf(mem_str, MAX_STRLEN, "%lld%s", total_mem, "MB");
+  field_set_int(FIELD_MEM_TOTAL,
+                (long long)sysconf(_SC_PHYS_PAGES) * (long long)sysconf(_SC_PAGE_SIZE));
 
   return;
 }
@@ -205,30 +221,30 @@ void detect_shell(void) {
   }
 
   if (STREQ(shell_name, "/bin/sh")) {
-    safe_strncpy(shell_str, "POSIX sh", MAX_STRLEN);
+    field_set_str(FIELD_SHELL, "POSIX sh");
   } else if (strstr(shell_name, "bash")) {
     shell_file = popen("bash --version | head -1", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "bash %.*s", 17, vers_str + 10);
+    field_printf(FIELD_SHELL, "bash %.*s", 17, vers_str + 10);
     pclose(shell_file);
   } else if (strstr(shell_name, "zsh")) {
     shell_file = popen("zsh --version", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "zsh %.*s", 5, vers_str + 4);
+    field_printf(FIELD_SHELL, "zsh %.*s", 5, vers_str + 4);
     pclose(shell_file);
   } else if (strstr(shell_name, "csh")) {
     shell_file = popen("csh --version | head -1", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "csh %.*s", 7, vers_str + 5);
+    field_printf(FIELD_SHELL, "csh %.*s", 7, vers_str + 5);
     pclose(shell_file);
   } else if (strstr(shell_name, "fish")) {
     shell_file = popen("fish --version", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "fish %.*s", 13, vers_str + 6);
+    field_printf(FIELD_SHELL, "fish %.*s", 13, vers_str + 6);
     pclose(shell_file);
   } else if (strstr(shell_name, "dash") || strstr(shell_name, "ash") || strstr(shell_name, "ksh")) {
     /* i don't have a version detection system for these, yet */
-    safe_strncpy(shell_str, shell_name, MAX_STRLEN);
+    field_set_str(FIELD_SHELL, shell_name);
   }
 
   return;
@@ -247,12 +263,10 @@ void detect_res(void) {
     screen = XDefaultScreenOfDisplay(disp);
     width = WidthOfScreen(screen);
     height = HeightOfScreen(screen);
-    snprintf(res_str, MAX_STRLEN, "%dx%d", width, height);
+    field_printf(FIELD_RES, "%dx%d", width, height);
     XCloseDisplay(disp);
-  } else {
-    safe_strncpy(res_str, "No X Server", MAX_STRLEN);
-    if (error)
-      ERR_REPORT("Problem detecting X display resolution.");
+  } else if (error) {
+    ERR_REPORT("Problem detecting X display resolution.");
   }
 
   return;
@@ -265,17 +279,17 @@ void detect_de(void) {
   char *curr_de;
 
   if ((curr_de = getenv("XDG_CURRENT_DESKTOP"))) {
-    safe_strncpy(de_str, curr_de, MAX_STRLEN);
+    field_set_str(FIELD_DE, curr_de);
   } else {
     if (getenv("GNOME_DESKTOP_SESSION_ID")) {
-      safe_strncpy(de_str, "Gnome", MAX_STRLEN);
+      field_set_str(FIELD_DE, "Gnome");
     } else if (getenv("MATE_DESKTOP_SESSION_ID")) {
-      safe_strncpy(de_str, "MATE", MAX_STRLEN);
+      field_set_str(FIELD_DE, "MATE");
     } else if (getenv("KDE_FULL_SESSION")) {
       /*	KDE_SESSION_VERSION only exists on KDE4+, so
         getenv will return NULL on KDE <= 3.
       */
-      snprintf(de_str, MAX_STRLEN, "KDE%s", getenv("KDE_SESSION_VERSION"));
+      field_printf(FIELD_DE, "KDE%s", getenv("KDE_SESSION_VERSION"));
     } else if (error) {
       ERR_REPORT("No desktop environment found.");
     }
@@ -308,7 +322,7 @@ void detect_wm(void) {
       if (!(XGetWindowProperty(disp, *wm_check_window, XInternAtom(disp, "_NET_WM_NAME", true), 0,
                                KB, false, XInternAtom(disp, "UTF8_STRING", true), &actual_type,
                                &actual_format, &nitems, &bytes, (unsigned char **)&wm_name))) {
-        safe_strncpy(wm_str, wm_name, MAX_STRLEN);
+        field_set_str(FIELD_WM, wm_name);
         XFree(wm_name);
       } else if (error) {
         ERR_REPORT("No _NET_WM_NAME property found.");
@@ -338,10 +352,10 @@ void detect_wm_theme(void) {
   char exec_str[MAX_STRLEN];
   FILE *wm_theme_file;
 
-  snprintf(exec_str, MAX_STRLEN, "detectwmtheme %s 2> /dev/null", wm_str);
+  snprintf(exec_str, MAX_STRLEN, "detectwmtheme %s 2> /dev/null", field_str(FIELD_WM));
 
   wm_theme_file = popen(exec_str, "r");
-  fgets(wm_theme_str, MAX_STRLEN, wm_theme_file);
+  field_read_line(FIELD_WM_THEME, wm_theme_file);
   pclose(wm_theme_file);
 
   return;
@@ -350,12 +364,9 @@ void detect_wm_theme(void) {
 /*	detect_gtk
   detects the theme, icon(s), and font(s) associated with a GTK DE (if present)
   --
-  CAVEAT: This function relies on the presence of 'detectgtk', a shell script.
-  If it isn't present somewhere in the PATH, the WM Theme will be set as 'Unknown'
+  CAVEAT: this is not implemented on Solaris yet, so the GTK fields are left undetected
   --
 */
 void detect_gtk(void) {
-  safe_strncpy(gtk_str, "Not implemented", MAX_STRLEN);
-
   return;
 }
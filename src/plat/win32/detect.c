@@ -28,7 +28,7 @@ extern int pclose(FILE *stream);
 #endif
 
 /* program includes */
-#include "../../arrays.h"
+#include "../../fields.h"
 #include "../../colors.h"
 #include "../../misc.h"
 #include "../../disp.h"
@@ -47,56 +47,49 @@ void detect_distro(void) {
   major = vers_info.dwMajorVersion;
   minor = vers_info.dwMinorVersion;
 
-  /* if distro_str was NOT set by the -D flag */
-  if (STREQ(distro_str, "Unknown")) {
+  /* if the distro was NOT set by the -D flag */
+  if (!field_isset(FIELD_OS)) {
     switch (major) {
     case 10:
-      safe_strncpy(distro_str, "Microsoft Windows 10", MAX_STRLEN);
+      field_set_str(FIELD_OS, "Microsoft Windows 10");
       break;
     case 6:
       switch (minor) {
       case 3:
-        safe_strncpy(distro_str, "Microsoft Windows 8.1", MAX_STRLEN);
+        field_set_str(FIELD_OS, "Microsoft Windows 8.1");
         break;
       case 2:
-        safe_strncpy(distro_str, "Microsoft Windows 8", MAX_STRLEN);
+        field_set_str(FIELD_OS, "Microsoft Windows 8");
         break;
       case 1:
-        safe_strncpy(distro_str, "Microsoft Windows 7", MAX_STRLEN);
+        field_set_str(FIELD_OS, "Microsoft Windows 7");
         break;
       case 0:
-        safe_strncpy(distro_str, "Microsoft Windows Vista", MAX_STRLEN);
+        field_set_str(FIELD_OS, "Microsoft Windows Vista");
         break;
       }
       break;
     case 5:
       switch (minor) {
       case 1:
-        safe_strncpy(distro_str, "Microsoft Windows XP", MAX_STRLEN);
+        field_set_str(FIELD_OS, "Microsoft Windows XP");
         break;
       case 0:
-        safe_strncpy(distro_str, "Microsoft Windows 2000", MAX_STRLEN);
+        field_set_str(FIELD_OS, "Microsoft Windows 2000");
         break;
       }
       break;
     default:
-      safe_strncpy(distro_str, "Microsoft Windows", MAX_STRLEN);
+      field_set_str(FIELD_OS, "Microsoft Windows");
       break;
     }
   }
 
-  // TODO: This should really go somewhere else.
-  if (major == 10 || (major == 6 && (minor == 3 || minor == 2))) {
-    safe_strncpy(host_color, TLBL, MAX_STRLEN);
-  } else {
-    safe_strncpy(host_color, TRED, MAX_STRLEN);
-  }
-
   return;
 }
 
 /*	detect_host
-  detects the computer's hostname and active user and formats them
+  detects the computer's hostname and active user
 */
 void detect_host(void) {
   char *given_user = "Unknown";
@@ -117,8 +110,8 @@ void detect_host(void) {
   gethostname(given_host, MAX_STRLEN);
 #endif
 
-  snprintf(host_str, MAX_STRLEN, "%s%s%s%s@%s%s%s%s", host_color, given_user, TNRM, TWHT, TNRM,
-           host_color, given_host, TNRM);
+  field_set_str(FIELD_USER, given_user);
+  field_set_str(FIELD_HOSTNAME, given_host);
 
   free(given_user);
 
@@ -151,8 +144,8 @@ void detect_kernel(void) {
     safe_strncpy(arch_str, "Unknown", MAX_STRLEN);
   }
 
-  snprintf(kernel_str, MAX_STRLEN, "Windows NT %d.%d build %d (%s)", (int)kern_info.dwMajorVersion,
-           (int)kern_info.dwMinorVersion, (int)kern_info.dwBuildNumber, arch_str);
+  field_printf(FIELD_KERNEL, "Windows NT %d.%d build %d (%s)", (int)kern_info.dwMajorVersion,
+               (int)kern_info.dwMinorVersion, (int)kern_info.dwBuildNumber, arch_str);
 
   return;
 }
@@ -162,20 +155,11 @@ void detect_kernel(void) {
 */
 void detect_uptime(void) {
   long uptime = 0;
-  unsigned int secs = 0;
-  unsigned int mins = 0;
-  unsigned int hrs = 0;
-  unsigned int days = 0;
 
   uptime = GetTickCount(); /* known problem: will rollover after 49.7 days */
   uptime /= 1000;
 
-  split_uptime(uptime, &secs, &mins, &hrs, &days);
-
-  if (days > 0)
-    snprintf(uptime_str, MAX_STRLEN, "%dd %dh %dm %ds", days, hrs, mins, secs);
-  else
-    snprintf(uptime_str, MAX_STRLEN, "%dh %dm %ds", hrs, mins, secs);
+  field_set_int(FIELD_UPTIME, uptime);
 
   return;
 }
@@ -200,7 +184,7 @@ void detect_pkgs(void) {
 
   globbuf.gl_offs = 1;
   glob(pattern, GLOB_DOOFFS, NULL, &globbuf);
-  snprintf(pkgs_str, MAX_STRLEN, "%d", (int)globbuf.gl_pathc);
+  field_set_int(FIELD_PKGS, globbuf.gl_pathc);
   globfree(&globbuf);
 #endif /* !__MINGW32__ */
 
@@ -212,11 +196,43 @@ void detect_pkgs(void) {
 */
 void detect_cpu(void) {
   HKEY hkey;
+  char cpu[MAX_STRLEN];
   DWORD str_size = MAX_STRLEN;
 
   RegOpenKey(HKEY_LOCAL_MACHINE, "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0", &hkey);
-  RegQueryValueEx(hkey, "ProcessorNameString", 0, NULL, (BYTE *)cpu_str, &str_size);
+  if (RegQueryValueEx(hkey, "ProcessorNameString", 0, NULL, (BYTE *)cpu, &str_size) ==
+      ERROR_SUCCESS)
+    field_set_str(FIELD_CPU_MODEL, cpu);
+
+  return;
+}
+
+/*	detect_topology
+  detects the computer's CPU topology (sockets, cores, threads and caches)
+  --
+  CAVEAT: this is not implemented on Windows yet, so the topology is left as 'Unknown'
+  --
+*/
+void detect_topology(void) {
+  return;
+}
+
+/*	detect_cpu_usage_begin
+  takes the first CPU time sample for detect_cpu_usage
+*/
+void detect_cpu_usage_begin(bool per_core) {
+  (void)per_core;
+  return;
+}
 
+/*	detect_cpu_usage
+  detects the CPU utilisation over a short sampling window
+  --
+  CAVEAT: this is not implemented on Windows yet, so the usage is left as 'Unknown'
+  --
+*/
+void detect_cpu_usage(unsigned int interval_ms) {
+  (void)interval_ms;
   return;
 }
 
@@ -225,23 +241,28 @@ void detect_cpu(void) {
 */
 void detect_gpu(void) {
   HKEY hkey;
+  char gpu[MAX_STRLEN];
   DWORD str_size = MAX_STRLEN;
 
   RegOpenKey(HKEY_LOCAL_MACHINE,
              "SYSTEM\\ControlSet001\\Control\\Class\\"
              "{4D36E968-E325-11CE-BFC1-08002BE10318}\\0000\\Settings",
              &hkey);
-  RegQueryValueEx(hkey, "Device Description", 0, NULL, (BYTE *)gpu_str, &str_size);
+  if (RegQueryValueEx(hkey, "Device Description", 0, NULL, (BYTE *)gpu, &str_size) ==
+      ERROR_SUCCESS)
+    field_set_str(FIELD_GPU, gpu);
 
   return;
 }
 
 /*	detect_disk
   detects the computer's total disk capacity and usage
+  argument bool per_fs: unused, the per-filesystem breakdown is Linux-only
 */
-void detect_disk(void) {
-  char *disk_unit;
-  long long totalBytes, freeBytes, usedBytes, disk_used, disk_total, disk_percentage;
+void detect_disk(bool per_fs) {
+  long long totalBytes, freeBytes;
+
+  (void)per_fs;
 
   char drive[MAX_STRLEN];
 #ifdef __MINGW32__
@@ -265,21 +286,9 @@ void detect_disk(void) {
 #endif
 
   if (GetDiskFreeSpaceEx(drive, NULL, (PULARGE_INTEGER)&totalBytes, (PULARGE_INTEGER)&freeBytes)) {
-    usedBytes = totalBytes - freeBytes;
-
-    if (usedBytes >= GB) {
-      disk_used = usedBytes / GB;
-      disk_unit = "G";
-    } else {
-      disk_used = usedBytes / MB;
-      disk_unit = "M";
-    }
-
-    disk_total = totalBytes / GB;
-    disk_percentage = (usedBytes * 100) / totalBytes;
-
-    snprintf(disk_str, MAX_STRLEN, "%lld%s / %lldG (%lld%%) [%s]", disk_used, disk_unit, disk_total,
-             disk_percentage, drive);
+    field_set_int(FIELD_DISK_TOTAL, totalBytes);
+    field_set_int(FIELD_DISK_USED, totalBytes - freeBytes);
+    field_list_add(FIELD_DISK_MOUNTS, drive);
   }
 
   return;
@@ -289,17 +298,13 @@ void detect_disk(void) {
   detects the computer's total and used RAM
 */
 void detect_mem(void) {
-  long long total_mem = 0;
-  long long used_mem = 0;
   MEMORYSTATUSEX mem_stat;
 
   mem_stat.dwLength = sizeof(mem_stat);
   GlobalMemoryStatusEx(&mem_stat);
 
-  total_mem = (long long)mem_stat.ullTotalPhys / MB;
-  used_mem = total_mem - ((long long)mem_stat.ullAvailPhys / MB);
-
-  snprintf(mem_str, MAX_STRLEN, "%lld%s / %lld%s", used_mem, "MB", total_mem, "MB");
+  field_set_int(FIELD_MEM_TOTAL, mem_stat.ullTotalPhys);
+  field_set_int(FIELD_MEM_USED, mem_stat.ullTotalPhys - mem_stat.ullAvailPhys);
 
   return;
 }
@@ -330,53 +335,53 @@ void detect_shell(void) {
 
 #ifndef __MINGW32__
   if (STREQ(shell_name, "/bin/sh")) {
-    safe_strncpy(shell_str, "POSIX sh", MAX_STRLEN);
+    field_set_str(FIELD_SHELL, "POSIX sh");
   } else if (strstr(shell_name, "bash")) {
     shell_file = popen("bash --version | head -1", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "bash %.*s", 17, vers_str + 10);
+    field_printf(FIELD_SHELL, "bash %.*s", 17, vers_str + 10);
     pclose(shell_file);
   } else if (strstr(shell_name, "zsh")) {
     shell_file = popen("zsh --version", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "zsh %.*s", 5, vers_str + 4);
+    field_printf(FIELD_SHELL, "zsh %.*s", 5, vers_str + 4);
     pclose(shell_file);
   } else if (strstr(shell_name, "csh")) {
     shell_file = popen("csh --version | head -1", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "csh %.*s", 7, vers_str + 5);
+    field_printf(FIELD_SHELL, "csh %.*s", 7, vers_str + 5);
     pclose(shell_file);
   } else if (strstr(shell_name, "fish")) {
     shell_file = popen("fish --version", "r");
     fgets(vers_str, MAX_STRLEN, shell_file);
-    snprintf(shell_str, MAX_STRLEN, "fish %.*s", 13, vers_str + 6);
+    field_printf(FIELD_SHELL, "fish %.*s", 13, vers_str + 6);
     pclose(shell_file);
   } else if (strstr(shell_name, "dash") || strstr(shell_name, "ash") || strstr(shell_name, "ksh")) {
     /* i don't have a version detection system for these, yet */
-    safe_strncpy(shell_str, shell_name, MAX_STRLEN);
+    field_set_str(FIELD_SHELL, shell_name);
   }
 #else /* __MINGW32__ */
   /* limited shell detection when running in Cygwin or MSYS2 */
   if (strstr(shell_name, "cmd.exe")) {
-    safe_strncpy(shell_str, "Command Prompt (cmd.exe)", MAX_STRLEN);
+    field_set_str(FIELD_SHELL, "Command Prompt (cmd.exe)");
   } else if (strstr(shell_name, "PowerShell")) {
-    safe_strncpy(shell_str, "Windows PowerShell", MAX_STRLEN);
+    field_set_str(FIELD_SHELL, "Windows PowerShell");
   } else if (strstr(shell_name, "/bin/sh")) {
-    safe_strncpy(shell_str, "POSIX sh", MAX_STRLEN);
+    field_set_str(FIELD_SHELL, "POSIX sh");
   } else if (strstr(shell_name, "bash")) {
-    snprintf(shell_str, MAX_STRLEN, "bash");
+    field_set_str(FIELD_SHELL, "bash");
   } else if (strstr(shell_name, "zsh")) {
-    snprintf(shell_str, MAX_STRLEN, "zsh");
+    field_set_str(FIELD_SHELL, "zsh");
   } else if (strstr(shell_name, "csh")) {
-    snprintf(shell_str, MAX_STRLEN, "csh");
+    field_set_str(FIELD_SHELL, "csh");
   } else if (strstr(shell_name, "fish")) {
-    snprintf(shell_str, MAX_STRLEN, "fish");
+    field_set_str(FIELD_SHELL, "fish");
   } else if (strstr(shell_name, "dash")) {
-    snprintf(shell_str, MAX_STRLEN, "dash");
+    field_set_str(FIELD_SHELL, "dash");
   } else if (strstr(shell_name, "ash")) {
-    snprintf(shell_str, MAX_STRLEN, "ash");
+    field_set_str(FIELD_SHELL, "ash");
   } else if (strstr(shell_name, "ksh")) {
-    snprintf(shell_str, MAX_STRLEN, "ksh");
+    field_set_str(FIELD_SHELL, "ksh");
   }
 #endif
 
@@ -393,7 +398,7 @@ void detect_res(void) {
   width = GetSystemMetrics(SM_CXVIRTUALSCREEN);
   height = GetSystemMetrics(SM_CYVIRTUALSCREEN);
 
-  snprintf(res_str, MAX_STRLEN, "%dx%d", width, height);
+  field_printf(FIELD_RES, "%dx%d", width, height);
 
   return;
 }
@@ -412,13 +417,13 @@ void detect_de(void) {
   minor = vers_info.dwMinorVersion;
 
   if (major == 10)
-    safe_strncpy(de_str, "Modern UI/Metro", MAX_STRLEN);
+    field_set_str(FIELD_DE, "Modern UI/Metro");
   else if (major == 6 && minor >= 2)
-    safe_strncpy(de_str, "Metro", MAX_STRLEN);
+    field_set_str(FIELD_DE, "Metro");
   else if (major == 6 && minor <= 1)
-    safe_strncpy(de_str, "Aero", MAX_STRLEN);
+    field_set_str(FIELD_DE, "Aero");
   else if (major == 5)
-    safe_strncpy(de_str, "Luna", MAX_STRLEN);
+    field_set_str(FIELD_DE, "Luna");
 
   return;
 }
@@ -428,7 +433,7 @@ void detect_de(void) {
   On Windows, this will always be DWM/Explorer.
 */
 void detect_wm(void) {
-  safe_strncpy(wm_str, "DWM/Explorer", MAX_STRLEN);
+  field_set_str(FIELD_WM, "DWM/Explorer");
 
   return;
 }
@@ -437,7 +442,7 @@ void detect_wm(void) {
   On Windows, detects the current theme running on DWM.
 */
 void detect_wm_theme(void) {
-  char tmp_theme[MAX_STRLEN] = "Unknown";
+  char tmp_theme[MAX_STRLEN] = "";
   char *suffix;
   HKEY hkey;
   DWORD str_size = MAX_STRLEN;
@@ -446,7 +451,7 @@ void detect_wm_theme(void) {
   RegQueryValueEx(hkey, "CurrentTheme", 0, NULL, (BYTE *)tmp_theme, &str_size);
 
   /* if we successfully retrieved a theme from the registry */
-  if (!STREQ(tmp_theme, "Unknown")) {
+  if (*tmp_theme) {
     safe_strncpy(tmp_theme, basename(tmp_theme), MAX_STRLEN);
     suffix = tmp_theme + strlen(tmp_theme) - 6;
 
@@ -454,22 +459,21 @@ void detect_wm_theme(void) {
     if (STREQ(suffix, ".theme")) {
       tmp_theme[strlen(tmp_theme) - 6] = '\0';
     }
-  }
 
-  safe_strncpy(wm_theme_str, tmp_theme, MAX_STRLEN);
+    field_set_str(FIELD_WM_THEME, tmp_theme);
+  }
 
   return;
 }
 
 /*	detect_gtk
-  On Windows, detects the font associated with Cygwin's terminal (mintty)
+  On Windows, detects the font associated with Cygwin's terminal (mintty);
+  there is no GTK theme to detect
 */
 void detect_gtk(void) {
-#ifdef __MINGW32__
-  snprintf(gtk_str, MAX_STRLEN, "none");
-#else
+#ifndef __MINGW32__
   FILE *gtk_file;
-  char font_str[MAX_STRLEN] = "Unknown";
+  char font_str[MAX_STRLEN] = "";
 
   gtk_file = popen("grep '^Font=.*' < $HOME/.minttyrc | "
                    "grep -o '[0-9A-z ]*$' | tr -d '\\r\\n'",
@@ -477,7 +481,8 @@ void detect_gtk(void) {
   fgets(font_str, MAX_STRLEN, gtk_file);
   pclose(gtk_file);
 
-  snprintf(gtk_str, MAX_STRLEN, "%s (Font)", font_str);
+  if (*font_str)
+    field_set_str(FIELD_FONT, font_str);
 #endif
 
   return;
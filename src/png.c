@@ -0,0 +1,214 @@
+/*	png.c
+**	-------------
+**
+**	A streaming PNG writer for 8-bit RGB images. Rows are filtered and
+**	compressed as they arrive, and the compressed stream is written out in
+**	IDAT chunks as it fills, so an image never has to be held in memory.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* program includes */
+#include "png.h"
+#include "deflate.h"
+
+#define BPP 3 /* bytes per pixel */
+
+/*	crc32
+  updates the PNG checksum crc with len bytes at p
+*/
+static uint32_t crc32(uint32_t crc, const unsigned char *p, size_t len) {
+  static uint32_t table[256];
+  uint32_t c;
+  int i, k;
+
+  if (!table[1]) {
+    for (i = 0; i < 256; i++) {
+      for (c = i, k = 0; k < 8; k++)
+        c = c & 1 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+      table[i] = c;
+    }
+  }
+
+  crc = ~crc;
+  while (len--)
+    crc = table[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+
+  return ~crc;
+}
+
+static void put32(unsigned char *p, uint32_t v) {
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+/*	png_chunk
+  writes a chunk of the given type
+  returns false if the file could not be written
+*/
+static bool png_chunk(FILE *file, const char *type, const unsigned char *data, size_t len) {
+  unsigned char head[8], crc[4];
+
+  put32(head, len);
+  memcpy(head + 4, type, 4);
+  put32(crc, crc32(crc32(0, head + 4, 4), data, len));
+
+  return fwrite(head, 1, 8, file) == 8 && (!len || fwrite(data, 1, len, file) == len) &&
+         fwrite(crc, 1, 4, file) == 4;
+}
+
+/*	png_idat
+  the deflate sink: every buffer of compressed data becomes an IDAT chunk
+*/
+static bool png_idat(void *ctx, const unsigned char *data, size_t len) {
+  return png_chunk(((struct png *)ctx)->file, "IDAT", data, len);
+}
+
+static unsigned char paeth(unsigned char a, unsigned char b, unsigned char c) {
+  int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+
+  if (pa <= pb && pa <= pc)
+    return a;
+  return pb <= pc ? b : c;
+}
+
+/*	png_filter
+  filters the row of n bytes with the given filter type into out
+  returns the sum of the filtered bytes taken as signed, the usual guess
+  at how well the row will compress
+*/
+static unsigned long png_filter(unsigned char *out, const unsigned char *row,
+                                const unsigned char *prev, size_t n, int type) {
+  unsigned long sum = 0;
+  unsigned char a, b, c;
+  size_t i;
+
+  out[0] = type;
+  for (i = 0; i < n; i++) {
+    a = i >= BPP ? row[i - BPP] : 0;
+    b = prev[i];
+    c = i >= BPP ? prev[i - BPP] : 0;
+
+    switch (type) {
+    case 0:
+      out[i + 1] = row[i];
+      break;
+    case 1:
+      out[i + 1] = row[i] - a;
+      break;
+    case 2:
+      out[i + 1] = row[i] - b;
+      break;
+    case 3:
+      out[i + 1] = row[i] - ((a + b) >> 1);
+      break;
+    default:
+      out[i + 1] = row[i] - paeth(a, b, c);
+    }
+
+    sum += out[i + 1] < 128 ? out[i + 1] : 256 - out[i + 1];
+  }
+
+  return sum;
+}
+
+/*	png_begin
+  writes the signature and header of a width x height image to file, whose
+  pixel data is compressed at the given level (0-9)
+  returns false if memory ran out or the file could not be written; otherwise
+  png_end has to be called to release the image's buffers
+*/
+bool png_begin(struct png *png, FILE *file, unsigned int width, unsigned int height, int level) {
+  static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+  unsigned char ihdr[13];
+  size_t row = (size_t)width * BPP;
+
+  memset(png, 0, sizeof(*png));
+  png->file = file;
+  png->width = width;
+  png->height = height;
+  png->level = level;
+
+  png->prev = calloc(row, 1);
+  png->best = malloc(row + 1);
+  png->trial = malloc(row + 1);
+
+  if (!png->prev || !png->best || !png->trial || !deflate_begin(&png->z, level, png_idat, png))
+    goto fail;
+
+  put32(ihdr, width);
+  put32(ihdr + 4, height);
+  ihdr[8] = 8;  /* bits per channel */
+  ihdr[9] = 2;  /* RGB */
+  ihdr[10] = 0; /* deflate */
+  ihdr[11] = 0; /* adaptive filtering */
+  ihdr[12] = 0; /* not interlaced */
+
+  if (fwrite(signature, 1, 8, file) == 8 && png_chunk(file, "IHDR", ihdr, 13))
+    return true;
+
+  deflate_free(&png->z);
+fail:
+  free(png->prev);
+  free(png->best);
+  free(png->trial);
+  return false;
+}
+
+/*	png_write_row
+  filters and compresses the next row of width RGB pixels
+  returns false if the file could not be written
+*/
+bool png_write_row(struct png *png, const unsigned char *rgb) {
+  size_t n = (size_t)png->width * BPP;
+  unsigned long sum, best_sum;
+  unsigned char *swap;
+  int type;
+
+  if (png->failed || png->rows == png->height)
+    return false;
+
+  /* stored output gains nothing from filtering; otherwise keep the filter
+     that leaves the smallest bytes */
+  best_sum = png_filter(png->best, rgb, png->prev, n, 0);
+  for (type = 1; png->level > 0 && type <= 4; type++) {
+    if ((sum = png_filter(png->trial, rgb, png->prev, n, type)) < best_sum) {
+      best_sum = sum;
+      swap = png->best;
+      png->best = png->trial;
+      png->trial = swap;
+    }
+  }
+
+  memcpy(png->prev, rgb, n);
+  png->rows++;
+
+  png->failed = !deflate_write(&png->z, png->best, n + 1);
+  return !png->failed;
+}
+
+/*	png_end
+  ends the compressed data and the image, and releases png's buffers
+  returns false if the image is incomplete or the file could not be written
+*/
+bool png_end(struct png *png) {
+  if (!png->failed && png->rows == png->height)
+    png->failed = !deflate_finish(&png->z) || !png_chunk(png->file, "IEND", NULL, 0);
+  else
+    png->failed = true;
+
+  deflate_free(&png->z);
+  free(png->prev);
+  free(png->best);
+  free(png->trial);
+
+  return !png->failed;
+}
@@ -0,0 +1,32 @@
+/*	png.h
+**	-------------
+**
+**	Types and function prototypes for png.c, the streaming PNG writer.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_PNG_H
+#define SCREENFETCH_C_PNG_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "deflate.h"
+
+#define PNG_DEFAULT_LEVEL 6
+
+/* an 8-bit RGB image being written a row at a time */
+struct png {
+  FILE *file;
+  unsigned int width, height, rows;
+  int level;
+  unsigned char *prev, *best, *trial; /* the previous row, and filtered rows */
+  struct deflate z;
+  bool failed;
+};
+
+bool png_begin(struct png *png, FILE *file, unsigned int width, unsigned int height, int level);
+bool png_write_row(struct png *png, const unsigned char *rgb);
+bool png_end(struct png *png);
+
+#endif /* SCREENFETCH_C_PNG_H */
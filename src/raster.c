@@ -0,0 +1,328 @@
+/*	raster.c
+**	-------------
+**
+**	Rasterizes text with ANSI colors into a PNG, for hosts that have no
+**	display to take a screenshot of. The text is laid out on a grid of
+**	character cells as a terminal would show it, then drawn with the bitmap
+**	font in font.c a pixel row at a time, straight into the PNG writer.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* program includes */
+#include "raster.h"
+#include "font.h"
+#include "png.h"
+#include "disp.h"
+
+#define SCALE 2
+#define CELL_W ((FONT_WIDTH + 1) * SCALE)
+#define CELL_H ((FONT_HEIGHT + 2) * SCALE)
+#define MARGIN CELL_W
+#define TAB 8
+#define MAX_PARAMS 16
+
+/* the xterm palette: the eight colors, then their bright forms */
+static const unsigned char palette[16][3] = {
+    {0x00, 0x00, 0x00}, {0xcd, 0x00, 0x00}, {0x00, 0xcd, 0x00}, {0xcd, 0xcd, 0x00},
+    {0x00, 0x00, 0xee}, {0xcd, 0x00, 0xcd}, {0x00, 0xcd, 0xcd}, {0xe5, 0xe5, 0xe5},
+    {0x7f, 0x7f, 0x7f}, {0xff, 0x00, 0x00}, {0x00, 0xff, 0x00}, {0xff, 0xff, 0x00},
+    {0x5c, 0x5c, 0xff}, {0xff, 0x00, 0xff}, {0x00, 0xff, 0xff}, {0xff, 0xff, 0xff},
+};
+
+static const unsigned char background[3] = {0x1c, 0x1c, 0x1c};
+
+/* colors are palette indexes, or -1 for the default */
+struct attr {
+  signed char fg, bg;
+  bool bold;
+};
+
+struct cell {
+  uint32_t cp;
+  struct attr attr;
+};
+
+/*	decode
+  decodes the UTF-8 character at p into *cp, as U+FFFD if it is malformed
+  returns a pointer past it
+*/
+static const char *decode(const char *p, const char *end, uint32_t *cp) {
+  const unsigned char *s = (const unsigned char *)p;
+  int n, i;
+
+  if (*s < 0x80) {
+    *cp = *s;
+    return p + 1;
+  }
+
+  n = *s >= 0xf0 ? 3 : *s >= 0xe0 ? 2 : *s >= 0xc0 ? 1 : 0;
+  if (!n || end - p <= n) {
+    *cp = 0xfffd;
+    return p + 1;
+  }
+
+  *cp = *s & (0x3f >> n);
+  for (i = 1; i <= n; i++) {
+    if ((s[i] & 0xc0) != 0x80) {
+      *cp = 0xfffd;
+      return p + i;
+    }
+    *cp = *cp << 6 | (s[i] & 0x3f);
+  }
+
+  return p + n + 1;
+}
+
+/*	sgr
+  applies the parameters of a Select Graphic Rendition sequence
+*/
+static void sgr(struct attr *attr, const int *params, int n) {
+  int i, v;
+
+  for (i = 0; i < n; i++) {
+    v = params[i];
+    if (v == 0) {
+      attr->fg = attr->bg = -1;
+      attr->bold = false;
+    } else if (v == 1 || v == 22) {
+      attr->bold = v == 1;
+    } else if (v >= 30 && v <= 37) {
+      attr->fg = v - 30;
+    } else if (v == 39) {
+      attr->fg = -1;
+    } else if (v >= 40 && v <= 47) {
+      attr->bg = v - 40;
+    } else if (v == 49) {
+      attr->bg = -1;
+    } else if (v >= 90 && v <= 97) {
+      attr->fg = v - 90 + 8;
+    } else if (v >= 100 && v <= 107) {
+      attr->bg = v - 100 + 8;
+    }
+  }
+}
+
+/*	escape
+  reads the escape sequence at p, applying it to attr if it sets colors
+  and skipping it otherwise
+  returns a pointer past it
+*/
+static const char *escape(const char *p, const char *end, struct attr *attr) {
+  int params[MAX_PARAMS], n = 0, v = 0;
+
+  if (++p == end || *p != '[')
+    return p < end ? p + 1 : p;
+
+  for (p++; p < end && *p >= 0x30 && *p <= 0x3f; p++) {
+    if (*p >= '0' && *p <= '9')
+      v = v < 1000 ? v * 10 + *p - '0' : v;
+    else if (*p == ';' && n < MAX_PARAMS - 1)
+      params[n++] = v, v = 0;
+  }
+  params[n++] = v;
+
+  while (p < end && *p >= 0x20 && *p <= 0x2f)
+    p++;
+  if (p == end)
+    return p;
+
+  if (*p == 'm')
+    sgr(attr, params, n);
+
+  return p + 1;
+}
+
+/*	layout
+  places the text on a grid of cols cells per row; with no grid, measures
+  the columns and rows it needs instead
+*/
+static void layout(const char *p, const char *end, struct cell *grid, size_t *cols,
+                   size_t *rows) {
+  struct attr attr = {-1, -1, false};
+  size_t x = 0, y = 0;
+  uint32_t cp;
+
+  while (p < end) {
+    if (*p == '\x1b') {
+      p = escape(p, end, &attr);
+      continue;
+    }
+
+    p = decode(p, end, &cp);
+
+    if (cp == '\n') {
+      x = 0;
+      y++;
+    } else if (cp == '\r') {
+      x = 0;
+    } else if (cp == '\t') {
+      x += TAB - x % TAB;
+    } else if (cp >= ' ') {
+      if (grid) {
+        grid[y * *cols + x].cp = cp;
+        grid[y * *cols + x].attr = attr;
+      }
+      x++;
+    }
+
+    if (!grid && x > *cols)
+      *cols = x;
+  }
+
+  if (!grid)
+    *rows = y + (x > 0);
+}
+
+/*	block_pixel
+  returns whether pixel (x, y) of a cell is set in the block element cp
+  (U+2580 to U+259F), which are drawn from their shapes so that they tile
+*/
+static bool block_pixel(uint32_t cp, int x, int y) {
+  /* the quadrants set in U+2596 to U+259F: 1 upper left, 2 upper right,
+     4 lower left, 8 lower right */
+  static const unsigned char quadrants[10] = {4, 8, 1, 13, 9, 7, 11, 2, 6, 14};
+
+  if (cp == 0x2580)
+    return y < CELL_H / 2;
+  if (cp <= 0x2588)
+    return y >= CELL_H - CELL_H * (int)(cp - 0x2580) / 8;
+  if (cp < 0x2590)
+    return x < CELL_W * (int)(0x2590 - cp) / 8;
+  if (cp == 0x2590)
+    return x >= CELL_W / 2;
+  if (cp == 0x2591)
+    return !(x % 2) && !(y % 2);
+  if (cp == 0x2592)
+    return (x + y) % 2;
+  if (cp == 0x2593)
+    return x % 2 || y % 2;
+  if (cp == 0x2594)
+    return y < CELL_H / 8;
+  if (cp == 0x2595)
+    return x >= CELL_W - CELL_W / 8;
+
+  return quadrants[cp - 0x2596] >> ((y >= CELL_H / 2) * 2 + (x >= CELL_W / 2)) & 1;
+}
+
+/*	glyph_pixel
+  returns whether pixel px of a glyph row is set
+*/
+static bool glyph_pixel(unsigned int bits, int px) {
+  int gx = px / SCALE;
+
+  return gx < FONT_WIDTH && bits >> (FONT_WIDTH - 1 - gx) & 1;
+}
+
+static void fill_background(unsigned char *rgb, unsigned int width) {
+  while (width--) {
+    memcpy(rgb, background, 3);
+    rgb += 3;
+  }
+}
+
+/*	draw_row
+  draws pixel row py of a row of cells into rgb, margins included
+*/
+static void draw_row(const struct cell *cells, size_t cols, int py, unsigned char *rgb) {
+  const unsigned char *glyph, *fg, *bg;
+  const struct cell *cell;
+  unsigned int bits;
+  int px, color, gy = py / SCALE - 1; /* a blank row above the glyphs */
+  bool on;
+
+  fill_background(rgb, MARGIN);
+  rgb += 3 * MARGIN;
+
+  for (cell = cells; cell < cells + cols; cell++) {
+    /* bold turns the eight colors bright, as terminals do */
+    color = cell->attr.fg < 0 ? 7 : cell->attr.fg;
+    fg = palette[cell->attr.bold && color < 8 ? color + 8 : color];
+    bg = cell->attr.bg < 0 ? background : palette[(int)cell->attr.bg];
+
+    if (!(glyph = font_glyph(cell->cp)) && (cell->cp < 0x2580 || cell->cp > 0x259f))
+      glyph = font_glyph('?');
+    bits = glyph && gy >= 0 && gy < FONT_HEIGHT ? glyph[gy] : 0;
+
+    for (px = 0; px < CELL_W; px++, rgb += 3) {
+      if (!glyph)
+        on = block_pixel(cell->cp, px, py);
+      else /* bold smears every stroke a pixel to the right */
+        on = glyph_pixel(bits, px) || (cell->attr.bold && px > 0 && glyph_pixel(bits, px - 1));
+      memcpy(rgb, on ? fg : bg, 3);
+    }
+  }
+
+  fill_background(rgb, MARGIN);
+}
+
+/*	raster_png
+  draws the len bytes of text, which may contain ANSI color escapes, into a
+  PNG at path compressed at the given level (0-9)
+  returns false (after reporting why) if the image could not be written
+*/
+bool raster_png(const char *text, size_t len, const char *path, int level) {
+  struct cell *grid = NULL, blank = {' ', {-1, -1, false}};
+  unsigned char *rgb = NULL;
+  size_t cols = 0, rows = 0, i, y;
+  unsigned int width, height;
+  struct png png;
+  FILE *file;
+  bool ok;
+  int py;
+
+  layout(text, text + len, NULL, &cols, &rows);
+  cols = cols ? cols : 1;
+  rows = rows ? rows : 1;
+  width = 2 * MARGIN + cols * CELL_W;
+  height = 2 * MARGIN + rows * CELL_H;
+
+  if (!(grid = malloc(rows * cols * sizeof(*grid))) || !(rgb = malloc((size_t)width * 3))) {
+    ERR_REPORT("Out of memory while rendering the PNG.");
+    free(grid);
+    return false;
+  }
+
+  for (i = 0; i < rows * cols; i++)
+    grid[i] = blank;
+  layout(text, text + len, grid, &cols, &rows);
+
+  if (!(file = fopen(path, "wb"))) {
+    ERR_REPORT("Could not create the PNG file.");
+    ok = false;
+  } else {
+    if ((ok = png_begin(&png, file, width, height, level))) {
+      fill_background(rgb, width);
+      for (py = 0; ok && py < MARGIN; py++)
+        ok = png_write_row(&png, rgb);
+
+      for (y = 0; ok && y < rows; y++) {
+        for (py = 0; ok && py < CELL_H; py++) {
+          draw_row(grid + y * cols, cols, py, rgb);
+          ok = png_write_row(&png, rgb);
+        }
+      }
+
+      fill_background(rgb, width);
+      for (py = 0; ok && py < MARGIN; py++)
+        ok = png_write_row(&png, rgb);
+
+      ok = png_end(&png) && ok;
+    }
+    ok = !fclose(file) && ok;
+
+    if (!ok)
+      ERR_REPORT("Could not write the PNG.");
+  }
+
+  free(grid);
+  free(rgb);
+
+  return ok;
+}
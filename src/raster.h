@@ -0,0 +1,16 @@
+/*	raster.h
+**	-------------
+**
+**	Function prototypes for raster.c, the text-to-PNG renderer.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_RASTER_H
+#define SCREENFETCH_C_RASTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+bool raster_png(const char *text, size_t len, const char *path, int level);
+
+#endif /* SCREENFETCH_C_RASTER_H */
@@ -0,0 +1,136 @@
+/*	render.c
+**	-------------
+**
+**	The output frame: everything screenfetch-c prints to stdout (logo,
+**	colors and values) is appended here with plain memcpy()s and written
+**	out with a single write() once the frame is complete, rather than in
+**	dozens of small printf()s.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+
+/* program includes */
+#include "misc.h"
+#include "render.h"
+#include "raster.h"
+
+/* a full frame (logo, escapes and values) comfortably fits in this */
+#define FRAME_SIZE (16 * KB)
+
+static char frame_static[FRAME_SIZE];
+static char *frame = frame_static;
+static size_t frame_len = 0;
+static size_t frame_cap = FRAME_SIZE;
+
+/*	frame_reserve
+  makes room for len more bytes, moving to the heap in the rare case that
+  the static buffer is too small
+  returns 0 on success, -1 if memory ran out or len is beyond any frame
+*/
+static int frame_reserve(size_t len) {
+  size_t cap = frame_cap;
+  char *grown;
+
+  if (len > SIZE_MAX - frame_len)
+    return -1;
+
+  if (frame_len + len <= frame_cap)
+    return 0;
+
+  while (cap < frame_len + len)
+    cap = cap > SIZE_MAX / 2 ? frame_len + len : cap * 2;
+
+  if (frame == frame_static) {
+    if (!(grown = malloc(cap)))
+      return -1;
+    memcpy(grown, frame, frame_len);
+  } else if (!(grown = realloc(frame, cap))) {
+    return -1;
+  }
+
+  frame = grown;
+  frame_cap = cap;
+  return 0;
+}
+
+/*	frame_append_n
+  appends the first len bytes of str to the frame
+*/
+void frame_append_n(const char *str, size_t len) {
+  if (frame_reserve(len))
+    return;
+
+  memcpy(frame + frame_len, str, len);
+  frame_len += len;
+}
+
+/*	frame_append
+  appends the string str to the frame
+*/
+void frame_append(const char *str) {
+  frame_append_n(str, strlen(str));
+}
+
+/*	frame_pad
+  appends n spaces to the frame
+*/
+void frame_pad(size_t n) {
+  if (frame_reserve(n))
+    return;
+
+  memset(frame + frame_len, ' ', n);
+  frame_len += n;
+}
+
+/*	frame_write
+  writes the frame to fd in one go (retrying only on short writes) and
+  empties it
+  returns 0 on success, -1 if the write failed
+*/
+int frame_write(int fd) {
+  size_t off = 0;
+  ssize_t n;
+  int ret = 0;
+
+  while (off < frame_len) {
+    if ((n = write(fd, frame + off, frame_len - off)) < 0) {
+      if (errno == EINTR)
+        continue;
+      ret = -1;
+      break;
+    }
+    off += n;
+  }
+
+  frame_len = 0;
+  return ret;
+}
+
+/*	frame_flush
+  writes the frame to stdout and empties it
+*/
+void frame_flush(void) {
+  /* anything stdio still holds belongs before the frame */
+  fflush(stdout);
+  frame_write(STDOUT_FILENO);
+}
+
+/*	frame_png
+  draws the frame into a PNG at path, compressed at the given level,
+  instead of writing it out, and empties it
+  returns false if the image could not be written
+*/
+bool frame_png(const char *path, int level) {
+  bool ok = raster_png(frame, frame_len, path, level);
+
+  frame_len = 0;
+  return ok;
+}
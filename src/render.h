@@ -0,0 +1,21 @@
+/*	render.h
+**	-------------
+**
+**	Function prototypes for render.c, the output frame buffer.
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+#ifndef SCREENFETCH_C_RENDER_H
+#define SCREENFETCH_C_RENDER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+void frame_append_n(const char *str, size_t len);
+void frame_append(const char *str);
+void frame_pad(size_t n);
+int frame_write(int fd);
+void frame_flush(void);
+bool frame_png(const char *path, int level);
+
+#endif /* SCREENFETCH_C_RENDER_H */
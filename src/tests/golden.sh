@@ -0,0 +1,116 @@
+#!/bin/sh
+#	golden.sh
+#	-------------
+#
+#	Runs the Linux detectors that work from a system's files over each fixture
+#	tree in src/tests/fixtures (through batch mode, as --output json) and
+#	compares the record with the golden one in src/tests/golden/FIXTURE.json.
+#	rpm is replaced by the one in src/tests/bin, which lists the packages of
+#	a fixture's var/lib/rpm/packages, so that the RPM-based fixtures count
+#	theirs through "rpm --root" whether or not rpm is installed.
+#	With PARSERTEST, the file parsers are also run over each tree in
+#	src/tests/parsers and their output compared with the golden one in
+#	src/tests/golden/parsers/TREE.txt.
+#	With -u, the golden files are rewritten from the current output instead.
+#	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+#
+#	Usage: golden.sh [-u] PROG [PARSERTEST]
+
+update=false
+if [ "$1" = "-u" ]; then
+	update=true
+	shift
+fi
+
+if [ $# -lt 1 ] || [ $# -gt 2 ]; then
+	echo "Usage: $0 [-u] PROG [PARSERTEST]" >&2
+	exit 2
+fi
+
+if [ "$(uname -s)" != Linux ]; then
+	echo "Skipping the golden tests: batch mode is only supported on Linux."
+	exit 0
+fi
+
+prog="$(cd "$(dirname "$1")" && pwd)/$(basename "$1")"
+tests="$(cd "$(dirname "$0")" && pwd)"
+passed=0
+failed=0
+
+if [ -n "$2" ]; then
+	parsertest="$(cd "$(dirname "$2")" && pwd)/$(basename "$2")"
+fi
+
+PATH="$tests/bin:$PATH"
+export PATH
+
+#	compare NAME GOLDEN ACTUAL
+#	checks (or, with -u, rewrites) one golden file
+compare() {
+	if $update; then
+		printf '%s\n' "$3" > "$2"
+		echo "UPDATED: $1"
+	elif [ ! -f "$2" ]; then
+		echo "FAIL: $1 (no golden file)"
+		failed=$((failed + 1))
+	elif [ "$3" = "$(cat "$2")" ]; then
+		echo "PASS: $1"
+		passed=$((passed + 1))
+	else
+		echo "FAIL: $1"
+		printf '%s\n' "$3" | diff "$2" -
+		failed=$((failed + 1))
+	fi
+}
+
+# run from the fixtures, so that the roots (and thus the records) are the same
+# wherever the tree was checked out
+cd "$tests/fixtures" || exit 1
+
+for fixture in */; do
+	name="${fixture%/}"
+	golden="$tests/golden/$name.json"
+
+	if ! actual="$(echo "$name" | "$prog" -E -b - -o json)"; then
+		echo "FAIL: $name (exit status)"
+		failed=$((failed + 1))
+		continue
+	fi
+
+	compare "$name" "$golden" "$actual"
+done
+
+if [ -n "$parsertest" ]; then
+	cd "$tests/parsers" || exit 1
+
+	for tree in */; do
+		name="${tree%/}"
+
+		if ! actual="$("$parsertest" "$name")"; then
+			echo "FAIL: parsers/$name (exit status)"
+			failed=$((failed + 1))
+			continue
+		fi
+
+		compare "parsers/$name" "$tests/golden/parsers/$name.txt" "$actual"
+	done
+
+	cd "$tests/fixtures" || exit 1
+fi
+
+$update && exit 0
+
+# all the fixtures at once, across several workers, must come out in order
+# and the same as one at a time
+roots="$(for fixture in */; do echo "${fixture%/}"; done)"
+expected="$(for root in $roots; do cat "$tests/golden/$root.json"; done)"
+if [ "$(echo "$roots" | "$prog" -E -b - -j 4 -o json)" = "$expected" ]; then
+	echo "PASS: all fixtures in one batch"
+	passed=$((passed + 1))
+else
+	echo "FAIL: all fixtures in one batch"
+	failed=$((failed + 1))
+fi
+
+echo "$passed passed, $failed failed."
+[ "$failed" -eq 0 ]
@@ -0,0 +1,290 @@
+/*	parsers.c
+ *
+ *	Runs the Linux file parsers over one fixture tree in src/tests/parsers
+ *	(its proc, sys and home directories standing in for the real ones) and
+ *	prints what each of them found as key=value lines, for golden.sh.
+ *	A parser whose input is missing from the tree is skipped.
+ *	It first checks that the distro aliases are still sorted for bsearch(),
+ *	and fails on every tree if they are not.
+ *	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+ */
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* linux-specific includes */
+#include <unistd.h>
+
+/* program includes */
+#include "../misc.h"
+#include "../util.h"
+#include "../distros.h"
+#include "../plat/linux/cgroup.h"
+#include "../plat/linux/cpuinfo.h"
+#include "../plat/linux/dconf.h"
+#include "../plat/linux/gtk.h"
+#include "../plat/linux/kde.h"
+#include "../plat/linux/meminfo.h"
+#include "../plat/linux/mounts.h"
+#include "../plat/linux/procstat.h"
+#include "../plat/linux/topology.h"
+
+/* the GSettings keys looked up, as schema and key */
+static const char *const dconf_keys[][2] = {
+    {"org.gnome.desktop.interface", "gtk-theme"},
+    {"org.gnome.desktop.interface", "icon-theme"},
+    {"org.gnome.desktop.interface", "font-name"},
+    {"org.mate.interface", "gtk-theme"},
+};
+
+static const char *root;
+
+/*	fixture
+  builds the path of name in the fixture tree into path
+  returns path if that exists, or NULL
+*/
+static const char *fixture(char *path, const char *name) {
+  snprintf(path, MAX_STRLEN, "%s/%s", root, name);
+
+  return FILE_EXISTS(path) ? path : NULL;
+}
+
+/*	test_cpuinfo
+  prints what cpuinfo_read makes of proc/cpuinfo and the cpufreq files
+*/
+static void test_cpuinfo(void) {
+  char path[MAX_STRLEN], sysfs_cpu[MAX_STRLEN];
+  struct cpuinfo ci;
+
+  if (!fixture(path, "proc/cpuinfo"))
+    return;
+
+  snprintf(sysfs_cpu, MAX_STRLEN, "%s/sys/devices/system/cpu", root);
+  if (!cpuinfo_read(path, sysfs_cpu, &ci)) {
+    printf("cpuinfo=failed\n");
+    return;
+  }
+
+  printf("cpuinfo.model=%s\n", ci.model);
+  printf("cpuinfo.packages=%u\ncpuinfo.cores=%u\ncpuinfo.threads=%u\n", ci.packages, ci.cores,
+         ci.threads);
+  printf("cpuinfo.mhz_min=%g\ncpuinfo.mhz_max=%g\ncpuinfo.mhz_cur=%g\n", ci.mhz_min, ci.mhz_max,
+         ci.mhz_cur);
+}
+
+/*	test_topology
+  prints what topology_read makes of sys/devices/system/cpu
+*/
+static void test_topology(void) {
+  char path[MAX_STRLEN];
+  struct topology t;
+  unsigned int i;
+
+  if (!fixture(path, "sys/devices/system/cpu"))
+    return;
+
+  if (!topology_read(path, &t)) {
+    printf("topology=failed\n");
+    return;
+  }
+
+  printf("topology.sockets=%u\ntopology.cores=%u\ntopology.threads=%u\n", t.sockets, t.cores,
+         t.threads);
+  printf("topology.smt=%u\ntopology.pcores=%u\ntopology.ecores=%u\n", t.smt, t.pcores, t.ecores);
+
+  for (i = 0; i < t.n_caches; i++) {
+    printf("topology.cache%u=%ux L%u%c %luK shared by %u\n", i, t.caches[i].instances,
+           t.caches[i].level, t.caches[i].type, t.caches[i].size_kb, t.caches[i].shared_cpus);
+  }
+}
+
+/*	test_meminfo
+  prints what meminfo_read and zram_read make of proc/meminfo and sys/block
+*/
+static void test_meminfo(void) {
+  char path[MAX_STRLEN];
+  struct meminfo mi;
+  struct zram_stat zs;
+
+  if (fixture(path, "proc/meminfo")) {
+    if (meminfo_read(path, &mi)) {
+      printf("meminfo.mem_total=%llu\nmeminfo.mem_available=%llu\n", mi.mem_total,
+             mi.mem_available);
+      printf("meminfo.shmem=%llu\nmeminfo.sunreclaim=%llu\n", mi.shmem, mi.sunreclaim);
+      printf("meminfo.cached=%llu\nmeminfo.dirty=%llu\n", mi.cached, mi.dirty);
+      printf("meminfo.swap_total=%llu\nmeminfo.swap_free=%llu\n", mi.swap_total, mi.swap_free);
+      printf("meminfo.anon_huge=%llu\nmeminfo.huge_total=%llu\n", mi.anon_huge, mi.huge_total);
+      printf("meminfo.huge_free=%llu\nmeminfo.huge_rsvd=%llu\n", mi.huge_free, mi.huge_rsvd);
+      printf("meminfo.huge_surp=%llu\nmeminfo.huge_size=%llu\n", mi.huge_surp, mi.huge_size);
+    } else {
+      printf("meminfo=failed\n");
+    }
+  }
+
+  if (fixture(path, "sys/block")) {
+    zram_read(path, &zs);
+    printf("zram.devices=%u\nzram.orig_bytes=%llu\nzram.compr_bytes=%llu\n", zs.devices,
+           zs.orig_bytes, zs.compr_bytes);
+  }
+}
+
+/*	test_procstat
+  prints the CPU times procstat_sample reads from proc/stat, and the usage
+  between it and proc/stat.next if there is a second sample
+*/
+static void test_procstat(void) {
+  char path[MAX_STRLEN];
+  struct cpu_sample before, after;
+  unsigned int i;
+
+  if (!fixture(path, "proc/stat"))
+    return;
+
+  if (!procstat_sample(path, &before, true)) {
+    printf("procstat=failed\n");
+    return;
+  }
+
+  printf("procstat.busy=%llu\nprocstat.total=%llu\n", before.all.busy, before.all.total);
+  for (i = 0; i < before.n_cpus; i++) {
+    printf("procstat.cpu%u=%llu/%llu\n", before.cpus[i].id, before.cpus[i].busy,
+           before.cpus[i].total);
+  }
+
+  if (fixture(path, "proc/stat.next") && procstat_sample(path, &after, true)) {
+    printf("procstat.usage=%d\n", procstat_usage(&before.all, &after.all));
+    for (i = 0; i < before.n_cpus && i < after.n_cpus; i++) {
+      printf("procstat.usage%u=%d\n", after.cpus[i].id,
+             procstat_usage(&before.cpus[i], &after.cpus[i]));
+    }
+    procstat_free(&after);
+  }
+
+  procstat_free(&before);
+}
+
+/*	test_mounts
+  prints the filesystems mounts_read keeps from proc/self/mountinfo; their
+  mount points are stat'ed on the host, so only what the file says is shown
+*/
+static void test_mounts(void) {
+  char path[MAX_STRLEN];
+  struct fs_usage *fs;
+  int n, i;
+
+  if (!fixture(path, "proc/self/mountinfo"))
+    return;
+
+  if ((n = mounts_read(path, true, &fs)) < 0) {
+    printf("mounts=failed\n");
+    return;
+  }
+
+  for (i = 0; i < n; i++) {
+    printf("mounts.%d=%s %s%s\n", i, fs[i].mount_point, fs[i].fstype,
+           fs[i].remote ? " remote" : "");
+  }
+
+  free(fs);
+}
+
+/*	test_cgroup
+  prints the limits cgroup_read finds for proc/self/cgroup in sys/fs/cgroup
+*/
+static void test_cgroup(void) {
+  char path[MAX_STRLEN], mount[MAX_STRLEN];
+  struct cgroup_limits cg;
+
+  if (!fixture(path, "proc/self/cgroup"))
+    return;
+
+  snprintf(mount, MAX_STRLEN, "%s/sys/fs/cgroup", root);
+  if (!cgroup_read(mount, path, CGROUP_MEMORY | CGROUP_CPU | CGROUP_CPUSET | CGROUP_PIDS, &cg)) {
+    printf("cgroup=failed\n");
+    return;
+  }
+
+  printf("cgroup.mem_max=%lld\ncgroup.mem_current=%lld\n", cg.mem_max, cg.mem_current);
+  printf("cgroup.cpus=%g\ncgroup.pids_max=%lld\n", cg.cpus, cg.pids_max);
+  printf("cgroup.cpuset=%s\ncgroup.cpuset_cpus=%u\n", cg.cpuset, cg.cpuset_cpus);
+}
+
+/*	test_desktop
+  prints the dconf, KDE and GTK settings found in home (and the compiled
+  GSettings schemas in share), for the desktop named in the file desktop
+*/
+static void test_desktop(void) {
+  char path[MAX_STRLEN], de[MAX_STRLEN];
+  char gtk2[MAX_STRLEN] = "", gtk3[MAX_STRLEN] = "", icons[MAX_STRLEN] = "",
+       font[MAX_STRLEN] = "", value[MAX_STRLEN];
+  size_t i;
+
+  if (!fixture(path, "home"))
+    return;
+
+  /* only the fixture's settings may be found, never the host's */
+  setenv("HOME", path, 1);
+  snprintf(path, MAX_STRLEN, "%s/home/.config", root);
+  setenv("XDG_CONFIG_HOME", path, 1);
+  snprintf(path, MAX_STRLEN, "%s/share", root);
+  setenv("XDG_DATA_DIRS", path, 1);
+  unsetenv("GSETTINGS_SCHEMA_DIR");
+  unsetenv("KDE_CONFIG_DIR");
+  unsetenv("KDEHOME");
+
+  for (i = 0; i < sizeof(dconf_keys) / sizeof(dconf_keys[0]); i++) {
+    value[0] = '\0';
+    dconf_read_string(dconf_keys[i][0], dconf_keys[i][1], value);
+    printf("dconf.%s.%s=%s\n", dconf_keys[i][0], dconf_keys[i][1], value);
+  }
+
+  value[0] = '\0';
+  kde_wm_theme(value);
+  printf("kde.wm_theme=%s\n", value);
+  value[0] = '\0';
+  kde_widget_style(value);
+  printf("kde.widget_style=%s\n", value);
+  value[0] = '\0';
+  kde_icon_theme(value);
+  printf("kde.icon_theme=%s\n", value);
+  value[0] = '\0';
+  kde_font(value);
+  printf("kde.font=%s\n", value);
+
+  if (!fixture(path, "desktop") || read_file(path, de, MAX_STRLEN) <= 0)
+    return;
+  de[strcspn(de, "\n")] = '\0';
+
+  gtk_read_settings(de, gtk2, gtk3, icons, font);
+  printf("gtk.gtk2=%s\ngtk.gtk3=%s\ngtk.icons=%s\ngtk.font=%s\n", gtk2, gtk3, icons, font);
+}
+
+int main(int argc, char **argv) {
+  const char *alias;
+
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s FIXTURE\n", argv[0]);
+    return 2;
+  }
+
+  /* an alias out of order is silently never found by distro_find */
+  if ((alias = distro_aliases_unsorted())) {
+    fprintf(stderr, "%s: the distro alias \"%s\" is out of order\n", argv[0], alias);
+    return 1;
+  }
+
+  root = argv[1];
+
+  test_cpuinfo();
+  test_topology();
+  test_meminfo();
+  test_procstat();
+  test_mounts();
+  test_cgroup();
+  test_desktop();
+
+  return 0;
+}
@@ -0,0 +1,519 @@
+/*	png.c
+ *
+ *	Round-trips data through deflate.c and images through png.c at every
+ *	compression level: what comes out is decoded again by the small inflater
+ *	and PNG reader below and compared with what went in. Prints a line per
+ *	case and exits non-zero if any of them did not come back intact.
+ *	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+ */
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* program includes */
+#include "../deflate.h"
+#include "../png.h"
+
+#define MAX_BITS 15
+
+/* a growing buffer, for the compressed data and the IDAT contents */
+struct buffer {
+  unsigned char *data;
+  size_t len, size;
+};
+
+/* an inflater's input and output */
+struct inflate {
+  const unsigned char *in;
+  size_t in_len, in_pos;
+  uint32_t bits;
+  unsigned int n_bits;
+  unsigned char *out;
+  size_t out_len, out_size;
+  bool bad;
+};
+
+/* a canonical Huffman code, as code counts per length and symbols in code order */
+struct huffman {
+  uint16_t count[MAX_BITS + 1];
+  uint16_t symbol[288];
+};
+
+static const uint16_t len_base[29] = {3,  4,  5,  6,  7,  8,  9,  10,  11,  13,
+                                      15, 17, 19, 23, 27, 31, 35, 43,  51,  59,
+                                      67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const unsigned char len_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                            2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t dist_base[30] = {1,    2,    3,    4,    5,    7,     9,     13,
+                                       17,   25,   33,   49,   65,   97,    129,   193,
+                                       257,  385,  513,  769,  1025, 1537,  2049,  3073,
+                                       4097, 6145, 8193, 12289, 16385, 24577};
+static const unsigned char dist_extra[30] = {0, 0, 0, 0, 1, 1, 2,  2,  3,  3,  4,  4,  5,  5,  6,
+                                             6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+static const unsigned char clen_order[19] = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+                                             11, 4,  12, 3, 13, 2, 14, 1, 15};
+
+static int failures;
+
+/*	sink
+  the deflate sink: appends the compressed data to the buffer ctx
+*/
+static bool sink(void *ctx, const unsigned char *data, size_t len) {
+  struct buffer *b = ctx;
+
+  if (b->len + len > b->size) {
+    b->size = (b->len + len) * 2;
+    if (!(b->data = realloc(b->data, b->size)))
+      return false;
+  }
+
+  memcpy(b->data + b->len, data, len);
+  b->len += len;
+  return true;
+}
+
+static unsigned int get_bits(struct inflate *s, unsigned int n) {
+  uint32_t v;
+
+  while (s->n_bits < n) {
+    if (s->in_pos == s->in_len) {
+      s->bad = true;
+      return 0;
+    }
+    s->bits |= (uint32_t)s->in[s->in_pos++] << s->n_bits;
+    s->n_bits += 8;
+  }
+
+  v = s->bits & ((1u << n) - 1);
+  s->bits >>= n;
+  s->n_bits -= n;
+  return v;
+}
+
+/*	huffman_build
+  builds the code with the n given code lengths
+  returns false if the lengths oversubscribe the code
+*/
+static bool huffman_build(struct huffman *h, const unsigned char *lens, int n) {
+  uint16_t offs[MAX_BITS + 1];
+  int left = 1, len, i;
+
+  memset(h->count, 0, sizeof(h->count));
+  for (i = 0; i < n; i++)
+    h->count[lens[i]]++;
+
+  for (len = 1; len <= MAX_BITS; len++) {
+    left = (left << 1) - h->count[len];
+    if (left < 0)
+      return false;
+  }
+
+  offs[1] = 0;
+  for (len = 1; len < MAX_BITS; len++)
+    offs[len + 1] = offs[len] + h->count[len];
+  for (i = 0; i < n; i++) {
+    if (lens[i])
+      h->symbol[offs[lens[i]]++] = i;
+  }
+
+  return true;
+}
+
+/*	huffman_decode
+  returns the next symbol in the code h, or -1 if the input is bad
+*/
+static int huffman_decode(struct inflate *s, const struct huffman *h) {
+  int code = 0, first = 0, index = 0, len;
+
+  for (len = 1; len <= MAX_BITS; len++) {
+    code |= get_bits(s, 1);
+    if (s->bad)
+      return -1;
+    if (code - h->count[len] < first)
+      return h->symbol[index + (code - first)];
+    index += h->count[len];
+    first = (first + h->count[len]) << 1;
+    code <<= 1;
+  }
+
+  s->bad = true;
+  return -1;
+}
+
+/*	inflate_codes
+  decodes the symbols of a Huffman-coded block
+*/
+static bool inflate_codes(struct inflate *s, const struct huffman *lit,
+                          const struct huffman *dist) {
+  int sym;
+  size_t len, d;
+
+  while ((sym = huffman_decode(s, lit)) != 256) {
+    if (sym < 0 || sym > 285)
+      return false;
+
+    if (sym < 256) {
+      if (s->out_len == s->out_size)
+        return false;
+      s->out[s->out_len++] = sym;
+      continue;
+    }
+
+    sym -= 257;
+    len = len_base[sym] + get_bits(s, len_extra[sym]);
+    if ((sym = huffman_decode(s, dist)) < 0 || sym > 29)
+      return false;
+    d = dist_base[sym] + get_bits(s, dist_extra[sym]);
+
+    if (s->bad || d > s->out_len || s->out_len + len > s->out_size)
+      return false;
+    for (; len; len--, s->out_len++)
+      s->out[s->out_len] = s->out[s->out_len - d];
+  }
+
+  return !s->bad;
+}
+
+/*	inflate_dynamic
+  reads the code lengths of a dynamic block, and then decodes it
+*/
+static bool inflate_dynamic(struct inflate *s) {
+  unsigned char lens[320];
+  struct huffman lit, dist, clen;
+  int hlit, hdist, hclen, i, sym, rep, prev;
+
+  hlit = get_bits(s, 5) + 257;
+  hdist = get_bits(s, 5) + 1;
+  hclen = get_bits(s, 4) + 4;
+  if (hlit > 286 || hdist > 30)
+    return false;
+
+  memset(lens, 0, sizeof(lens));
+  for (i = 0; i < hclen; i++)
+    lens[clen_order[i]] = get_bits(s, 3);
+  if (s->bad || !huffman_build(&clen, lens, 19))
+    return false;
+
+  for (i = 0; i < hlit + hdist;) {
+    if ((sym = huffman_decode(s, &clen)) < 0)
+      return false;
+
+    if (sym < 16) {
+      lens[i++] = sym;
+      continue;
+    }
+
+    if (sym == 16) {
+      if (!i)
+        return false;
+      prev = lens[i - 1];
+      rep = 3 + get_bits(s, 2);
+    } else {
+      prev = 0;
+      rep = sym == 17 ? 3 + get_bits(s, 3) : 11 + get_bits(s, 7);
+    }
+
+    if (s->bad || i + rep > hlit + hdist)
+      return false;
+    while (rep--)
+      lens[i++] = prev;
+  }
+
+  return lens[256] && huffman_build(&lit, lens, hlit) && huffman_build(&dist, lens + hlit, hdist) &&
+         inflate_codes(s, &lit, &dist);
+}
+
+/*	inflate_fixed
+  decodes a block in the fixed code, built over all of its 288 and 32 symbols
+*/
+static bool inflate_fixed(struct inflate *s) {
+  unsigned char lens[288 + 32];
+  struct huffman lit, dist;
+  int i;
+
+  for (i = 0; i < 288; i++)
+    lens[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+  memset(lens + 288, 5, 32);
+
+  return huffman_build(&lit, lens, 288) && huffman_build(&dist, lens + 288, 32) &&
+         inflate_codes(s, &lit, &dist);
+}
+
+/*	inflate_stored
+  copies a stored block
+*/
+static bool inflate_stored(struct inflate *s) {
+  size_t len, nlen;
+
+  s->bits = 0;
+  s->n_bits = 0;
+
+  if (s->in_pos + 4 > s->in_len)
+    return false;
+  len = s->in[s->in_pos] | s->in[s->in_pos + 1] << 8;
+  nlen = s->in[s->in_pos + 2] | s->in[s->in_pos + 3] << 8;
+  s->in_pos += 4;
+
+  if (len != (~nlen & 0xffff) || s->in_pos + len > s->in_len || s->out_len + len > s->out_size)
+    return false;
+
+  memcpy(s->out + s->out_len, s->in + s->in_pos, len);
+  s->in_pos += len;
+  s->out_len += len;
+  return true;
+}
+
+/*	zlib_inflate
+  decompresses the zlib stream in into out, which holds up to out_size bytes
+  returns the length of the data, or -1 if the stream is bad or its checksum
+  does not match
+*/
+static long zlib_inflate(const unsigned char *in, size_t in_len, unsigned char *out,
+                         size_t out_size) {
+  struct inflate s = {in, in_len, 2, 0, 0, out, 0, out_size, false};
+  uint32_t a = 1, b = 0, adler;
+  bool last, ok;
+  size_t i;
+
+  if (in_len < 6 || (in[0] & 0x0f) != 8 || (in[0] << 8 | in[1]) % 31 || in[1] & 0x20)
+    return -1;
+
+  do {
+    last = get_bits(&s, 1);
+    switch (get_bits(&s, 2)) {
+    case 0:
+      ok = inflate_stored(&s);
+      break;
+    case 1:
+      ok = inflate_fixed(&s);
+      break;
+    case 2:
+      ok = inflate_dynamic(&s);
+      break;
+    default:
+      ok = false;
+    }
+    if (!ok || s.bad)
+      return -1;
+  } while (!last);
+
+  /* the checksum starts at the next whole byte */
+  if (s.in_pos + 4 != in_len)
+    return -1;
+  adler = (uint32_t)in[s.in_pos] << 24 | in[s.in_pos + 1] << 16 | in[s.in_pos + 2] << 8 |
+          in[s.in_pos + 3];
+
+  for (i = 0; i < s.out_len; i++) {
+    a = (a + out[i]) % 65521;
+    b = (b + a) % 65521;
+  }
+
+  return (b << 16 | a) == adler ? (long)s.out_len : -1;
+}
+
+static uint32_t get32(const unsigned char *p) {
+  return (uint32_t)p[0] << 24 | p[1] << 16 | p[2] << 8 | p[3];
+}
+
+static uint32_t crc32(const unsigned char *p, size_t len) {
+  uint32_t c = 0xffffffff;
+  int k;
+
+  while (len--) {
+    for (c ^= *p++, k = 0; k < 8; k++)
+      c = c & 1 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+  }
+
+  return ~c;
+}
+
+static unsigned char paeth(unsigned char a, unsigned char b, unsigned char c) {
+  int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+
+  if (pa <= pb && pa <= pc)
+    return a;
+  return pb <= pc ? b : c;
+}
+
+/*	png_read
+  checks the PNG file of the given size and decodes its RGB pixels into rgb
+  returns false if it is not the expected image
+*/
+static bool png_read(const unsigned char *file, size_t size, unsigned int width,
+                     unsigned int height, unsigned char *rgb) {
+  static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+  struct buffer idat = {NULL, 0, 0};
+  size_t pos = 8, len, row = (size_t)width * 3, x;
+  unsigned char *raw, *zero, *line, *prev, a, b, c;
+  bool ihdr = false, iend = false, ok = false;
+  unsigned int y;
+  long n;
+
+  if (size < 8 || memcmp(file, signature, 8))
+    return false;
+
+  while (!iend && pos + 12 <= size) {
+    len = get32(file + pos);
+    if (pos + 12 + len > size || crc32(file + pos + 4, len + 4) != get32(file + pos + 8 + len))
+      break;
+
+    if (!memcmp(file + pos + 4, "IHDR", 4)) {
+      ihdr = len == 13 && get32(file + pos + 8) == width && get32(file + pos + 12) == height &&
+             !memcmp(file + pos + 16, "\x08\x02\x00\x00\x00", 5);
+    } else if (!memcmp(file + pos + 4, "IDAT", 4)) {
+      if (!sink(&idat, file + pos + 8, len))
+        break;
+    } else if (!memcmp(file + pos + 4, "IEND", 4)) {
+      iend = pos + 12 == size;
+    }
+
+    pos += 12 + len;
+  }
+
+  raw = malloc((row + 1) * height + 1);
+  prev = zero = calloc(row + 1, 1);
+
+  if (!ihdr || !iend || !raw || !zero ||
+      (n = zlib_inflate(idat.data, idat.len, raw, (row + 1) * height + 1)) < 0 ||
+      (size_t)n != (row + 1) * height)
+    goto done;
+
+  for (y = 0; y < height; y++, prev = rgb - row) {
+    line = raw + y * (row + 1);
+    if (line[0] > 4)
+      goto done;
+
+    for (x = 0; x < row; x++) {
+      a = x >= 3 ? rgb[x - 3] : 0;
+      b = prev[x];
+      c = x >= 3 ? prev[x - 3] : 0;
+      rgb[x] = line[x + 1] + (line[0] == 0   ? 0
+                              : line[0] == 1 ? a
+                              : line[0] == 2 ? b
+                              : line[0] == 3 ? (a + b) >> 1
+                                             : paeth(a, b, c));
+    }
+    rgb += row;
+  }
+  ok = true;
+
+done:
+  free(zero);
+  free(raw);
+  free(idat.data);
+  return ok;
+}
+
+/*	report
+  prints the outcome of one case
+*/
+static void report(bool ok, const char *what, const char *name, int level) {
+  printf("%s: %s %s at level %d\n", ok ? "PASS" : "FAIL", what, name, level);
+  failures += !ok;
+}
+
+/*	test_deflate
+  compresses len bytes of data at the given level and inflates them again
+*/
+static void test_deflate(const char *name, const unsigned char *data, size_t len, int level) {
+  struct buffer out = {NULL, 0, 0};
+  struct deflate z;
+  unsigned char *back = malloc(len + 1);
+  bool ok = back && deflate_begin(&z, level, sink, &out);
+
+  if (ok) {
+    ok = deflate_write(&z, data, len / 3) && deflate_write(&z, data + len / 3, len - len / 3) &&
+         deflate_finish(&z);
+    deflate_free(&z);
+  }
+
+  ok = ok && zlib_inflate(out.data, out.len, back, len + 1) == (long)len &&
+       !memcmp(back, data, len);
+  report(ok, "deflate", name, level);
+
+  free(back);
+  free(out.data);
+}
+
+/*	test_png
+  writes the width x height image rgb at the given level and reads it back
+*/
+static void test_png(const char *name, const unsigned char *rgb, unsigned int width,
+                     unsigned int height, int level) {
+  size_t row = (size_t)width * 3, size;
+  unsigned char *file = NULL, *back = malloc(row * height + 1);
+  struct png png;
+  unsigned int y;
+  FILE *tmp = tmpfile();
+  bool ok = tmp && back && png_begin(&png, tmp, width, height, level);
+
+  if (ok) {
+    for (y = 0; y < height; y++)
+      png_write_row(&png, rgb + y * row);
+    ok = png_end(&png);
+  }
+
+  if (ok && fflush(tmp) == 0 && (size = ftell(tmp)) > 0 && (file = malloc(size))) {
+    rewind(tmp);
+    ok = fread(file, 1, size, tmp) == size && png_read(file, size, width, height, back) &&
+         !memcmp(back, rgb, row * height);
+  } else {
+    ok = false;
+  }
+  report(ok, "png", name, level);
+
+  if (tmp)
+    fclose(tmp);
+  free(file);
+  free(back);
+}
+
+int main(void) {
+  static const unsigned char pixel[3] = {0x98, 0x22, 0x7d};
+  static const char text[] = "screenfetch-c: the Bash screenFetch tool rewritten in C. ";
+  const size_t big = 200000;
+  unsigned char *noise = malloc(big), *prose = malloc(big), *image = malloc(big);
+  uint32_t seed = 1;
+  unsigned int w = 200, h = 100, x, y;
+  size_t i;
+  int level;
+
+  if (!noise || !prose || !image)
+    return 2;
+
+  /* bytes of every value, text with long repeats, and an image with gradients,
+     noise and flat areas */
+  for (i = 0; i < big; i++) {
+    seed = seed * 1103515245 + 12345;
+    noise[i] = seed >> 16;
+    prose[i] = text[i % (sizeof(text) - 1)] ^ (i % 4099 ? 0 : noise[i]);
+  }
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w; x++) {
+      unsigned char *p = image + (y * w + x) * 3;
+      p[0] = x < 50 ? x * 5 : x < 100 ? noise[y * w + x] : 0x98;
+      p[1] = y * 2;
+      p[2] = x >= 150 ? 0x7d : x ^ y;
+    }
+  }
+
+  for (level = 0; level <= 9; level++) {
+    test_deflate("empty", noise, 0, level);
+    test_deflate("high bytes", (const unsigned char *)"\x98\xfe\xc0\x90\xff", 5, level);
+    test_deflate("noise", noise, big, level);
+    test_deflate("text", prose, big, level);
+    test_png("1x1", pixel, 1, 1, level);
+    test_png("200x100", image, w, h, level);
+  }
+
+  free(noise);
+  free(prose);
+  free(image);
+
+  printf("%s\n", failures ? "The round trips failed." : "All round trips passed.");
+  return failures != 0;
+}
@@ -0,0 +1,337 @@
+/*	logopack.c
+**	-------------
+**
+**	A build-time tool that turns plain-text logo sources (logos/NAME.txt) into
+**	a logo pack (see logopack.h), either as a file to be dropped into a
+**	logo directory or, with -c, as a C header embedding the default pack.
+**
+**	A source holds one logo line per text line, with colors written as
+**	{TLCY}, {TNRM} etc. It may start with directives:
+**	  %name NAME          the logo's name (defaults to the file's basename)
+**	  %colors C1 C2 C3    the colors for the logo, data labels and values
+**	Like the rest of screenfetch-c, this file is licensed under the MIT license.
+*/
+
+/* standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* program includes */
+#include "../logopack.h"
+
+#define MAX_LOGOS 1024
+
+struct source {
+  char name[256];
+  unsigned char colors[3];
+  unsigned char *data; /* widths, then the encoded lines */
+  size_t data_len;
+  unsigned int n_lines;
+  unsigned int width;
+};
+
+struct buffer {
+  unsigned char *data;
+  size_t len, cap;
+};
+
+#define COLOR_NAME(name) #name,
+static const char *const color_names[LOGOPACK_N_COLORS] = {LOGOPACK_COLORS(COLOR_NAME)};
+#undef COLOR_NAME
+
+static const char *progname = "logopack";
+
+/*	die
+  reports a fatal error in file (if any) and exits
+*/
+static void die(const char *file, const char *msg) {
+  if (file)
+    fprintf(stderr, "%s: %s: %s\n", progname, file, msg);
+  else
+    fprintf(stderr, "%s: %s\n", progname, msg);
+  exit(EXIT_FAILURE);
+}
+
+/*	buf_append
+  appends len bytes of data to b
+*/
+static void buf_append(struct buffer *b, const void *data, size_t len) {
+  if (b->len + len > b->cap) {
+    while (b->len + len > b->cap)
+      b->cap = b->cap ? b->cap * 2 : 4096;
+    if (!(b->data = realloc(b->data, b->cap)))
+      die(NULL, "out of memory");
+  }
+
+  memcpy(b->data + b->len, data, len);
+  b->len += len;
+}
+
+static void buf_u8(struct buffer *b, unsigned int v) {
+  unsigned char c = v;
+
+  buf_append(b, &c, 1);
+}
+
+static void buf_u16(struct buffer *b, unsigned int v) {
+  unsigned char p[2] = {v & 0xff, v >> 8 & 0xff};
+
+  buf_append(b, p, 2);
+}
+
+static void buf_u32(struct buffer *b, uint32_t v) {
+  unsigned char p[4] = {v & 0xff, v >> 8 & 0xff, v >> 16 & 0xff, v >> 24 & 0xff};
+
+  buf_append(b, p, 4);
+}
+
+/*	color_index
+  returns the token index of the len-byte color name at s, or -1
+*/
+static int color_index(const char *s, size_t len) {
+  int i;
+
+  for (i = 0; i < LOGOPACK_N_COLORS; i++) {
+    if (strlen(color_names[i]) == len && !strncmp(s, color_names[i], len))
+      return i;
+  }
+
+  return -1;
+}
+
+/*	read_source
+  reads the whole file at path into a malloc'd, NUL-terminated buffer
+*/
+static char *read_source(const char *path) {
+  struct buffer b = {NULL, 0, 0};
+  char chunk[4096];
+  size_t n;
+  FILE *f;
+
+  if (!(f = fopen(path, "rb")))
+    die(path, "cannot open");
+
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+    buf_append(&b, chunk, n);
+
+  if (ferror(f))
+    die(path, "read error");
+
+  fclose(f);
+  buf_append(&b, "", 1);
+  return (char *)b.data;
+}
+
+/*	encode_line
+  appends line to text with its colors tokenized, returning its width on a
+  terminal: each UTF-8 character takes one column and tabs advance to the
+  next multiple of eight
+*/
+static unsigned int encode_line(const char *path, const char *line, struct buffer *text) {
+  const unsigned char *p = (const unsigned char *)line;
+  const char *close;
+  unsigned int width = 0;
+  int color;
+
+  while (*p) {
+    if (*p == '{' && (close = strchr((const char *)p, '}')) &&
+        (color = color_index((const char *)p + 1, close - (const char *)p - 1)) >= 0) {
+      buf_u8(text, LOGOPACK_TOKEN + color);
+      p = (const unsigned char *)close + 1;
+      continue;
+    }
+
+    if (*p == 0x1B || LOGOPACK_IS_TOKEN(*p))
+      die(path, "raw control characters are not allowed; write colors as {TNRM} etc.");
+
+    if (*p == '\t')
+      width = (width / 8 + 1) * 8;
+    else if ((*p & 0xC0) != 0x80)
+      width++;
+
+    buf_u8(text, *p++);
+  }
+
+  buf_u8(text, '\0');
+  return width;
+}
+
+/*	parse_source
+  reads and encodes the logo source at path into s
+*/
+static void parse_source(const char *path, struct source *s) {
+  struct buffer widths = {NULL, 0, 0}, text = {NULL, 0, 0};
+  char *buf = read_source(path), *line, *next, *end;
+  const char *base;
+  unsigned int width;
+  bool directives = true;
+  char c1[16], c2[16], c3[16];
+  int i1, i2, i3;
+
+  base = (base = strrchr(path, '/')) ? base + 1 : path;
+  snprintf(s->name, sizeof(s->name), "%s", base);
+  if ((end = strrchr(s->name, '.')) && end != s->name)
+    *end = '\0';
+
+  memset(s->colors, 0, sizeof(s->colors));
+  s->n_lines = s->width = 0;
+
+  for (line = buf; *line; line = next) {
+    if ((next = strchr(line, '\n')))
+      *next++ = '\0';
+    else
+      next = line + strlen(line);
+
+    if ((end = line + strlen(line)) > line && end[-1] == '\r')
+      end[-1] = '\0';
+
+    if (directives && line[0] == '%') {
+      if (!strncmp(line, "%name ", 6)) {
+        snprintf(s->name, sizeof(s->name), "%s", line + 6);
+      } else if (!strncmp(line, "%colors ", 8)) {
+        if (sscanf(line + 8, "%15s %15s %15s", c1, c2, c3) != 3 ||
+            (i1 = color_index(c1, strlen(c1))) < 0 || (i2 = color_index(c2, strlen(c2))) < 0 ||
+            (i3 = color_index(c3, strlen(c3))) < 0)
+          die(path, "%colors takes three color names");
+        s->colors[0] = i1;
+        s->colors[1] = i2;
+        s->colors[2] = i3;
+      } else {
+        die(path, "unknown directive");
+      }
+      continue;
+    }
+
+    directives = false;
+    width = encode_line(path, line, &text);
+    buf_u16(&widths, width);
+
+    if (width > s->width)
+      s->width = width;
+    if (++s->n_lines > 0xffff)
+      die(path, "too many lines");
+  }
+
+  if (s->n_lines == 0)
+    die(path, "no logo lines");
+  if (s->width > 0xffff)
+    die(path, "lines too wide");
+
+  buf_append(&widths, text.data, text.len);
+  s->data = widths.data;
+  s->data_len = widths.len;
+
+  free(text.data);
+  free(buf);
+}
+
+static int cmp_source(const void *a, const void *b) {
+  return strcmp(((const struct source *)a)->name, ((const struct source *)b)->name);
+}
+
+/*	build_pack
+  lays the sorted sources out as a pack in out
+*/
+static void build_pack(struct source *sources, size_t n, struct buffer *out) {
+  size_t names_len = 0, i;
+  uint32_t name_off, data_off, size;
+
+  for (i = 0; i < n; i++)
+    names_len += strlen(sources[i].name) + 1;
+
+  name_off = LOGOPACK_HEADER_SIZE + n * LOGOPACK_ENTRY_SIZE;
+  data_off = name_off + names_len;
+
+  size = data_off;
+  for (i = 0; i < n; i++)
+    size += sources[i].data_len;
+
+  buf_append(out, LOGOPACK_MAGIC, 8);
+  buf_u32(out, n);
+  buf_u32(out, size);
+
+  for (i = 0; i < n; i++) {
+    buf_u32(out, name_off);
+    buf_u32(out, data_off);
+    buf_u32(out, sources[i].data_len);
+    buf_u16(out, sources[i].n_lines);
+    buf_u16(out, sources[i].width);
+    buf_append(out, sources[i].colors, 3);
+    buf_u8(out, 0);
+
+    name_off += strlen(sources[i].name) + 1;
+    data_off += sources[i].data_len;
+  }
+
+  for (i = 0; i < n; i++)
+    buf_append(out, sources[i].name, strlen(sources[i].name) + 1);
+
+  for (i = 0; i < n; i++)
+    buf_append(out, sources[i].data, sources[i].data_len);
+}
+
+/*	write_header
+  writes the pack as a C header defining logo_pack[]
+*/
+static void write_header(FILE *f, const struct buffer *pack) {
+  size_t i;
+
+  fprintf(f, "/* generated from logos/NAME.txt by src/tools/logopack.c; do not edit */\n"
+             "static const unsigned char logo_pack[%zu] = {",
+          pack->len);
+
+  for (i = 0; i < pack->len; i++)
+    fprintf(f, "%s%u,", i % 24 ? "" : "\n", pack->data[i]);
+
+  fprintf(f, "\n};\n");
+}
+
+int main(int argc, char **argv) {
+  static struct source sources[MAX_LOGOS];
+  struct buffer pack = {NULL, 0, 0};
+  bool header = false;
+  size_t n = 0, i;
+  int arg = 1;
+  FILE *f;
+
+  if (argc > 1 && !strcmp(argv[1], "-c")) {
+    header = true;
+    arg++;
+  }
+
+  if (argc - arg < 2) {
+    fprintf(stderr, "usage: %s [-c] OUTPUT SOURCE...\n", progname);
+    return EXIT_FAILURE;
+  }
+
+  for (i = arg + 1; i < (size_t)argc; i++) {
+    if (n == MAX_LOGOS)
+      die(NULL, "too many logos");
+    parse_source(argv[i], &sources[n++]);
+  }
+
+  qsort(sources, n, sizeof(sources[0]), cmp_source);
+
+  for (i = 1; i < n; i++) {
+    if (!strcmp(sources[i].name, sources[i - 1].name))
+      die(sources[i].name, "duplicate logo name");
+  }
+
+  build_pack(sources, n, &pack);
+
+  if (!(f = fopen(argv[arg], header ? "w" : "wb")))
+    die(argv[arg], "cannot create");
+
+  if (header)
+    write_header(f, &pack);
+  else
+    fwrite(pack.data, 1, pack.len, f);
+
+  if (fclose(f))
+    die(argv[arg], "write error");
+
+  return EXIT_SUCCESS;
+}
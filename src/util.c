@@ -13,6 +13,13 @@
 #include <stdbool.h>
 #include <unistd.h>
 
+#ifdef __linux
+#include <fcntl.h>
+#elif !defined(__CYGWIN__) && !defined(__MSYS__) && !defined(__MINGW32__)
+#include <spawn.h>
+#include <sys/wait.h>
+#endif /* __linux */
+
 /* program includes */
 #include "disp.h"
 #include "misc.h"
@@ -23,6 +30,10 @@
 #include "plat/win32/bitmap.h"
 #endif
 
+#ifdef __linux
+#include "plat/linux/x11.h"
+#endif /* __linux */
+
 /*	safe_strncpy
   calls strncpy with the given params, then inserts a terminating NULL
   returns a pointer to a string containing the copied data
@@ -51,25 +62,53 @@ void split_uptime(long uptime, unsigned int *secs, unsigned int *mins, unsigned
   return;
 }
 
+#if !defined(__linux) && !defined(__CYGWIN__) && !defined(__MSYS__) && !defined(__MINGW32__)
+/*	run_capture
+  runs an external screenshot tool, without a shell in between
+  returns true if it exited successfully
+*/
+static bool run_capture(char *const argv[]) {
+  extern char **environ;
+  pid_t pid;
+  int status;
+
+  if (posix_spawnp(&pid, argv[0], NULL, NULL, argv, environ))
+    return false;
+
+  return waitpid(pid, &status, 0) == pid && WIFEXITED(status) && !WEXITSTATUS(status);
+}
+#endif
+
 /*	take_screenshot
-  takes a screenshot and saves it to $HOME/screenfetch_screenshot.png
+  counts down delay seconds, then takes a screenshot and saves it to path,
+  or to $HOME/screenfetch_screenshot.png if path is NULL; on Linux the
+  screen is read from the X server and written as a PNG at the given
+  compression level (0-9)
+  returns false if the screenshot could not be saved
 */
-void take_screenshot(bool verbose) {
-#if !defined(__CYGWIN__) && !defined(__MSYS__) && !defined(__MINGW32__)
-  int call_status = 1;
+bool take_screenshot(const char *path, unsigned int delay, int level, bool verbose) {
   char file_loc[MAX_STRLEN];
+  bool ok;
+
+#if defined(__CYGWIN__) || defined(__MSYS__) || defined(__MINGW32__)
+  safe_strncpy(file_loc, path ? path : "screenfetch_screenshot.bmp", MAX_STRLEN);
+#else
+  if (path)
+    safe_strncpy(file_loc, path, MAX_STRLEN);
+  else
+    snprintf(file_loc, MAX_STRLEN, "%s/screenfetch_screenshot.png",
+             getenv("HOME") ? getenv("HOME") : ".");
 #endif
 
-  printf("%s", "Taking shot in 3..");
-  fflush(stdout);
-  sleep(1);
-  printf("%s", "2..");
-  fflush(stdout);
-  sleep(1);
-  printf("%s", "1..");
-  fflush(stdout);
-  sleep(1);
-  printf("%s\n", "0");
+  if (delay) {
+    printf("Taking shot in %u..", delay);
+    fflush(stdout);
+    while (delay--) {
+      sleep(1);
+      printf(delay ? "%u.." : "%u\n", delay);
+      fflush(stdout);
+    }
+  }
 
 #if defined(__CYGWIN__) || defined(__MSYS__) || defined(__MINGW32__)
   HDC screen_dc = GetDC(NULL);
@@ -81,78 +120,178 @@ void take_screenshot(bool verbose) {
   HBITMAP bitmap = CreateCompatibleBitmap(screen_dc, horiz, vert);
   HBITMAP old_bitmap = SelectObject(mem_dc, bitmap);
 
+  (void)level;
   BitBlt(mem_dc, 0, 0, horiz, vert, screen_dc, 0, 0, SRCCOPY);
   bitmap = SelectObject(mem_dc, old_bitmap);
 
-  if (createBitmapFile("screenfetch_screenshot.bmp", bitmap, mem_dc) == 0) {
-    VERBOSE_OUT("Screenshot successfully saved.", "");
-  } else {
-    ERR_REPORT("Problem saving screenshot.");
-  }
+  ok = createBitmapFile(file_loc, bitmap, mem_dc) == 0;
 
   DeleteDC(screen_dc);
   DeleteDC(mem_dc);
-
-#elif defined(__APPLE__) && defined(__MACH__)
-  call_status = system("screencapture -x ~/screenfetch_screenshot.png 2> /dev/null");
+#elif defined(__linux)
+  ok = x11_screenshot(file_loc, level);
+#else
+  {
+#if defined(__APPLE__) && defined(__MACH__)
+    char *argv[] = {"screencapture", "-x", file_loc, NULL};
 #else
-  call_status = system("scrot ~/screenfetch_screenshot.png 2> /dev/null");
+    char *argv[] = {"scrot", file_loc, NULL};
 #endif
 
-#if !defined(__CYGWIN__) && !defined(__MSYS__) && !defined(__MINGW32__)
-  safe_strncpy(file_loc, getenv("HOME"), MAX_STRLEN);
-  strncat(file_loc, "/screenfetch_screenshot.png", MAX_STRLEN);
+    (void)level;
+    ok = run_capture(argv);
+  }
+#endif
 
-  if (FILE_EXISTS(file_loc) && verbose) {
-    VERBOSE_OUT("Screenshot successfully saved.", "");
-  } else if (call_status && error) {
+  if (ok && verbose)
+    VERBOSE_OUT("Screenshot successfully saved to ", file_loc);
+#if !defined(__linux)
+  else if (!ok && error)
     ERR_REPORT("Problem saving screenshot.");
-  }
 #endif
 
-  return;
+  return ok;
+}
+
+/*	the directories in $PATH, opened once on the first command_in_path call
+  so that later lookups are a single faccessat() per directory
+*/
+#ifdef __linux
+#define MAX_PATH_DIRS 128
+
+static int path_dir_fds[MAX_PATH_DIRS];
+static int path_dir_count = -1;
+
+/*	path_index_build
+  opens every directory listed in $PATH, skipping missing ones
+*/
+static void path_index_build(void) {
+  char dir[MAX_STRLEN];
+  const char *env, *entry, *end;
+  size_t len;
+  int fd;
+
+  path_dir_count = 0;
+
+  if (!(env = getenv("PATH")))
+    return;
+
+  for (entry = env; path_dir_count < MAX_PATH_DIRS; entry = end + 1) {
+    if (!(end = strchr(entry, ':')))
+      end = entry + strlen(entry);
+
+    /* an empty entry means the current directory */
+    len = end - entry;
+    if (len == 0)
+      safe_strncpy(dir, ".", MAX_STRLEN);
+    else if (len < MAX_STRLEN) {
+      memcpy(dir, entry, len);
+      dir[len] = '\0';
+    } else
+      dir[0] = '\0';
+
+    if (dir[0] && (fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC)) >= 0)
+      path_dir_fds[path_dir_count++] = fd;
+
+    if (!*end)
+      break;
+  }
 }
 
 /*	returns 1 if command is in PATH, otherwise 0
  */
-#ifdef __linux
 int command_in_path(const char *command) {
-  char *env, *env_copy, *str, *token;
-  char *file = NULL;
-  int j, len, rv = 0;
-
-  env = getenv("PATH");
+  int i;
 
-  if (!command || !env) {
+  if (!command || !*command)
     return 0;
+
+  if (path_dir_count < 0)
+    path_index_build();
+
+  for (i = 0; i < path_dir_count; i++) {
+    if (!faccessat(path_dir_fds[i], command, F_OK, 0))
+      return 1;
   }
 
-  env_copy = strdup(env);
+  return 0;
+}
+#endif /* __linux */
 
-  /*	though not really needed, stop after 9999 iterations
-    to prevent any potential endless loop
-  */
-  for (j = 0, str = env_copy; j < 9999; ++j, str = NULL) {
-    len = strlen(command);
-    token = strtok(str, ":");
+/*	read_file_at
+  reads up to size - 1 bytes of the file at path (relative to the directory
+  fd dirfd, or AT_FDCWD) into buf with a single read() and NUL-terminates it
+  returns the number of bytes read, or -1 on failure
+*/
+#ifdef __linux
+ssize_t read_file_at(int dirfd, const char *path, char *buf, size_t size) {
+  int fd;
+  ssize_t len;
 
-    if (token == NULL || len == 0) {
-      rv = 0;
-      break;
-    }
+  if ((fd = openat(dirfd, path, O_RDONLY | O_CLOEXEC)) < 0)
+    return -1;
 
-    file = malloc(strlen(token) + len + 2);
-    sprintf(file, "%s/%s", token, command);
+  len = read(fd, buf, size - 1);
+  close(fd);
 
-    if (FILE_EXISTS(file)) {
-      rv = 1;
-      free(file);
-      break;
+  buf[len > 0 ? len : 0] = '\0';
+  return len;
+}
+
+/*	read_file
+  read_file_at, relative to the current directory
+*/
+ssize_t read_file(const char *path, char *buf, size_t size) {
+  return read_file_at(AT_FDCWD, path, buf, size);
+}
+#endif /* __linux */
+
+/*	read_file_alloc
+  reads the whole file at path (which may be a /proc file reporting a size
+  of 0) into a malloc'd, NUL-terminated buffer, storing its length in len
+  returns NULL on failure; the caller frees the buffer
+*/
+#ifdef __linux
+char *read_file_alloc(const char *path, size_t *len) {
+  size_t cap = 64 * KB, used = 0;
+  char *buf, *grown;
+  ssize_t n;
+  int fd;
+
+  if ((fd = open(path, O_RDONLY | O_CLOEXEC)) < 0)
+    return NULL;
+
+  if (!(buf = malloc(cap))) {
+    close(fd);
+    return NULL;
+  }
+
+  while ((n = read(fd, buf + used, cap - used - 1)) > 0) {
+    used += n;
+
+    if (cap - used - 1 == 0) {
+      if (!(grown = realloc(buf, cap * 2))) {
+        free(buf);
+        close(fd);
+        return NULL;
+      }
+
+      buf = grown;
+      cap *= 2;
     }
-    free(file);
   }
 
-  free(env_copy);
-  return rv;
+  close(fd);
+
+  if (n < 0) {
+    free(buf);
+    return NULL;
+  }
+
+  buf[used] = '\0';
+  if (len)
+    *len = used;
+
+  return buf;
 }
 #endif /* __linux */
@@ -12,9 +12,14 @@
 char *safe_strncpy(char *destination, const char *source, size_t num);
 void split_uptime(long uptime, unsigned int *secs, unsigned int *mins, unsigned int *hrs,
                   unsigned int *days);
-void take_screenshot(bool verbose);
+bool take_screenshot(const char *path, unsigned int delay, int level, bool verbose);
 #ifdef __linux
+#include <sys/types.h>
+
 int command_in_path(const char *command);
+ssize_t read_file_at(int dirfd, const char *path, char *buf, size_t size);
+ssize_t read_file(const char *path, char *buf, size_t size);
+char *read_file_alloc(const char *path, size_t *len);
 #endif /* __linux */
 
 #endif /* SCREENFETCH_C_UTIL_H */